@@ -0,0 +1,99 @@
+// Benchmark of the diameter / eccentricity computation: one plain breadth-first search per airport against the
+// bit-parallel search of Graph::eccentricities (256 sources per pass), with one thread and with every hardware
+// thread, and against the iFUB bounds of Graph::ifubDiameter, which only certify the diameter. Runs on the bundled network and on a synthetic network ten times larger, made of ten copies of it with
+// a share of the routes of each copy rewired into the next one.
+//
+// Run from the build directory (the data is read from ../data/).
+// Usage: diameterBench [copies] [rewired share]
+// (configure with -DCMAKE_BUILD_TYPE=Release, unoptimized builds are about ten times slower)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include "../classes/supervisor.h"
+
+using namespace std;
+
+// Eccentricities with one breadth-first search per node, the way the diameter used to be computed
+static vector<int> plainEccentricities(const Graph& graph) {
+    int n = graph.getSize();
+    vector<int> ecc(n + 1, 0), hops(n + 1), queue(n);
+    for (int src = 1; src <= n; src++) {
+        fill(hops.begin(), hops.end(), -1);
+        hops[src] = 0;
+        queue[0] = src;
+        for (int head = 0, tail = 1; head < tail; head++) {
+            int u = queue[head];
+            ecc[src] = hops[u];
+            for (const auto& e : graph.adj(u))
+                if (hops[e.dest] == -1) {
+                    hops[e.dest] = hops[u] + 1;
+                    queue[tail++] = e.dest;
+                }
+        }
+    }
+    return ecc;
+}
+
+// Copies of the network, where each route stays in its copy except for a share that goes to the next copy
+static Graph replicate(const Graph& graph, int copies, double rewired) {
+    int n = graph.getSize();
+    Graph big(n * copies);
+    for (int i = 0; i < graph.nrAirlines(); i++)
+        big.addAirline(i, graph.getAirline(i));
+    for (int c = 0; c < copies; c++)
+        for (int v = 1; v <= n; v++)
+            big.addAirport(c * n + v, graph.getAirport(v));
+
+    mt19937 rng(2023);
+    bernoulli_distribution rewire(rewired);
+    for (int c = 0; c < copies; c++)
+        for (int u = 1; u <= n; u++)
+            for (const auto& e : graph.adj(u)) {
+                int to = rewire(rng) ? (c + 1) % copies : c;
+                for (int airline : graph.airlinesOf(e))
+                    big.addEdge(c * n + u, to * n + e.dest, airline, e.distance);
+            }
+    big.buildCSR();
+    return big;
+}
+
+template <class F>
+static double timeMs(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void run(const char* name, const Graph& graph, bool plain) {
+    int threads = (int) thread::hardware_concurrency();
+    vector<int> a, b, c;
+    printf("%s: %d airports, %d routes\n", name, graph.getSize(), graph.nrEdges());
+    if (plain) printf("  one BFS per airport        %10.1f ms\n", timeMs([&] {a = plainEccentricities(graph);}));
+    printf("  bit-parallel, 1 thread     %10.1f ms\n", timeMs([&] {b = graph.eccentricities(1);}));
+    printf("  bit-parallel, %2d thread(s) %10.1f ms\n", threads, timeMs([&] {c = graph.eccentricities(threads);}));
+    SearchWorkspace ws;
+    int searches;
+    double ifub = 0;
+    printf("  iFUB                       %10.1f ms", timeMs([&] {ifub = graph.ifubDiameter(false, ws, searches);}));
+    printf(" (%d searches)\n", searches);
+    int diameter = *max_element(c.begin(), c.end());
+    printf("  diameter %d%s\n\n", diameter,
+           (plain && a != b) || b != c || ifub != diameter ? "  (MISMATCH between the methods)" : "");
+}
+
+int main(int argc, char* argv[]) {
+    int copies = argc > 1 ? atoi(argv[1]) : 10;
+    double rewired = argc > 2 ? atof(argv[2]) : 0.05;
+
+    Supervisor supervisor;
+    const Graph& graph = supervisor.getGraph();
+    run("bundled network", graph, true);
+
+    Graph big = replicate(graph, copies, rewired);
+    char name[64];
+    snprintf(name, sizeof(name), "synthetic network (%dx)", copies);
+    run(name, big, true);
+}
@@ -0,0 +1,81 @@
+// Benchmark of the great-circle distance: the haversine formula Graph::distance used to evaluate (degrees converted
+// and pow/asin on every call) against Coordinates::distance one pair at a time (sin/cos and the libm arcsine) and
+// against the batch kernel of Coordinates from one airport to every other one, which uses AVX2 when the CPU has it.
+//
+// Run from the build directory (the data is read from ../data/).
+// Usage: haversineBench [sources]
+// (configure with -DCMAKE_BUILD_TYPE=Release, unoptimized builds are about ten times slower)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "../classes/supervisor.h"
+
+using namespace std;
+
+static double haversine(double lat1, double lon1, double lat2, double lon2) {
+    double dLat = (lat2 - lat1) * M_PI / 180.0;
+    double dLon = (lon2 - lon1) * M_PI / 180.0;
+    lat1 = (lat1) * M_PI / 180.0;
+    lat2 = (lat2) * M_PI / 180.0;
+    double a = pow(sin(dLat / 2), 2) + pow(sin(dLon / 2), 2) * cos(lat1) * cos(lat2);
+    return 6371 * 2 * asin(sqrt(a));
+}
+
+static double elapsed(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    Supervisor supervisor;
+    const Graph& graph = supervisor.getGraph();
+    const Coordinates& coordinates = graph.getCoordinates();
+    int n = graph.getSize();
+    int sources = argc > 1 ? min(atoi(argv[1]), n) : 500;
+
+    vector<double> latitude(n + 1), longitude(n + 1);
+    vector<int> all(n);
+    for (int v = 1; v <= n; v++) {
+        latitude[v] = graph.getAirport(v).getLatitude();
+        longitude[v] = graph.getAirport(v).getLongitude();
+        all[v - 1] = v;
+    }
+
+    double checksum[3] = {0, 0, 0}, maxError = 0;
+    vector<double> batch(n);
+
+    auto start = chrono::steady_clock::now();
+    for (int s = 1; s <= sources; s++)
+        for (int v = 1; v <= n; v++)
+            checksum[0] += haversine(latitude[s], longitude[s], latitude[v], longitude[v]);
+    double oldSeconds = elapsed(start);
+
+    start = chrono::steady_clock::now();
+    for (int s = 1; s <= sources; s++)
+        for (int v = 1; v <= n; v++)
+            checksum[1] += Coordinates::distance(latitude[s], longitude[s], latitude[v], longitude[v]);
+    double scalarSeconds = elapsed(start);
+
+    start = chrono::steady_clock::now();
+    for (int s = 1; s <= sources; s++) {
+        coordinates.distances(s, all.data(), n, batch.data());
+        for (int i = 0; i < n; i++) checksum[2] += batch[i];
+    }
+    double batchSeconds = elapsed(start);
+
+    for (int s = 1; s <= sources; s++) {
+        coordinates.distances(s, all.data(), n, batch.data());
+        for (int i = 0; i < n; i++)
+            maxError = max(maxError, fabs(batch[i] - haversine(latitude[s], longitude[s], latitude[i + 1], longitude[i + 1])));
+    }
+
+    double pairs = (double) sources * n;
+    printf("%.0f distances (%d airports x %d)\n", pairs, sources, n);
+    printf("  haversine with pow/asin  %8.1f ms  (%.1f M/s)\n", oldSeconds * 1000, pairs / oldSeconds / 1e6);
+    printf("  Coordinates::distance   %8.1f ms  (%.1f M/s)\n", scalarSeconds * 1000, pairs / scalarSeconds / 1e6);
+    printf("  batch kernel (%s)     %8.1f ms  (%.1f M/s)\n", Coordinates::vectorized() ? "AVX2" : "scalar",
+           batchSeconds * 1000, pairs / batchSeconds / 1e6);
+    printf("  largest difference to the haversine formula: %.2e km (checksums %.3f %.3f %.3f)\n", maxError,
+           checksum[0], checksum[1], checksum[2]);
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Microbenchmark of the priority queues used by the distance searches: the original MinHeap (positions in an
+// unordered_map) against the indexed DAryHeap with 2, 4 and 8 children per node.
+// Every heap runs the same Dijkstra over the same random sparse graph, and then the same sequence of
+// insert / decreaseKey / removeMin operations.
+//
+// Usage: heapBench [nodes] [degree] [repetitions]
+// (configure with -DCMAKE_BUILD_TYPE=Release, unoptimized builds mostly measure the function call overhead)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../classes/minHeap.h"
+#include "../classes/dAryHeap.h"
+
+using namespace std;
+
+struct Arc {
+    int target;
+    double weight;
+};
+
+struct Sparse {
+    vector<int> offsets;
+    vector<Arc> arcs;
+};
+
+// Random directed graph with the given average out-degree and great-circle-like weights (km)
+static Sparse randomGraph(int n, int degree, mt19937& rng) {
+    uniform_int_distribution<int> node(0, n - 1);
+    uniform_real_distribution<double> km(50, 5000);
+    Sparse g;
+    g.offsets.resize(n + 1);
+    for (int u = 0; u < n; u++) {
+        g.offsets[u] = (int) g.arcs.size();
+        for (int i = 0; i < degree; i++)
+            g.arcs.push_back({node(rng), km(rng)});
+    }
+    g.offsets[n] = (int) g.arcs.size();
+    return g;
+}
+
+// Common interface over both heaps, so that the workloads are written once
+struct OldHeap {
+    MinHeap<int, double> heap;
+    explicit OldHeap(int n) : heap(n, -1) {}
+    void push(int key, double value) {
+        if (heap.hasKey(key)) heap.decreaseKey(key, value);
+        else heap.insert(key, value);
+    }
+    int pop() {return heap.removeMin();}
+    bool empty() {return heap.getSize() == 0;}
+};
+
+template <int D>
+struct NewHeap {
+    DAryHeap<double, D> heap;
+    explicit NewHeap(int n) : heap(n) {}
+    void push(int key, double value) {heap.push(key, value);}
+    int pop() {return heap.removeMin();}
+    bool empty() {return heap.empty();}
+};
+
+template <class Heap>
+static double dijkstra(const Sparse& g, int src, vector<double>& dist) {
+    int n = (int) g.offsets.size() - 1;
+    dist.assign(n, 1e18);
+    vector<bool> done(n, false);
+    Heap q(n);
+    dist[src] = 0;
+    q.push(src, 0);
+    double checksum = 0;
+    while (!q.empty()) {
+        int u = q.pop();
+        done[u] = true;
+        checksum += dist[u];
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; i++) {
+            const Arc& a = g.arcs[i];
+            double d = dist[u] + a.weight;
+            if (done[a.target] || d >= dist[a.target]) continue;
+            dist[a.target] = d;
+            q.push(a.target, d);
+        }
+    }
+    return checksum;
+}
+
+// Fills the heap, then alternates decreases of random keys with removals until it is empty
+template <class Heap>
+static double operations(int n, const vector<double>& values, const vector<int>& keys) {
+    Heap q(n);
+    for (int k = 0; k < n; k++) q.push(k, values[k]);
+    double checksum = 0;
+    size_t next = 0;
+    while (!q.empty()) {
+        for (int i = 0; i < 4 && next < keys.size(); i++, next++)
+            q.push(keys[next], values[keys[next]] * 0.5 - (double) next);
+        checksum += q.pop();
+    }
+    return checksum;
+}
+
+template <class F>
+static double timeMs(F f, int repetitions, double& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) checksum += f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repetitions;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int degree = argc > 2 ? atoi(argv[2]) : 8;
+    int repetitions = argc > 3 ? atoi(argv[3]) : 5;
+
+    mt19937 rng(2023);
+    Sparse g = randomGraph(n, degree, rng);
+    vector<double> values(n), dist;
+    vector<int> keys(2 * (size_t) n);
+    uniform_real_distribution<double> value(0, 1e6);
+    uniform_int_distribution<int> key(0, n - 1);
+    for (double& v : values) v = value(rng);
+    for (int& k : keys) k = key(rng);
+
+    printf("%d nodes, %d arcs, %d repetitions\n", n, (int) g.arcs.size(), repetitions);
+    printf("%-22s %14s %14s\n", "heap", "dijkstra (ms)", "ops mix (ms)");
+
+    double checksum = 0;
+    auto report = [&](const char* name, auto search, auto mix) {
+        double a = timeMs(search, repetitions, checksum);
+        double b = timeMs(mix, repetitions, checksum);
+        printf("%-22s %14.2f %14.2f\n", name, a, b);
+    };
+    report("MinHeap (binary, map)",
+           [&] {return dijkstra<OldHeap>(g, 0, dist);}, [&] {return operations<OldHeap>(n, values, keys);});
+    report("DAryHeap<double, 2>",
+           [&] {return dijkstra<NewHeap<2>>(g, 0, dist);}, [&] {return operations<NewHeap<2>>(n, values, keys);});
+    report("DAryHeap<double, 4>",
+           [&] {return dijkstra<NewHeap<4>>(g, 0, dist);}, [&] {return operations<NewHeap<4>>(n, values, keys);});
+    report("DAryHeap<double, 8>",
+           [&] {return dijkstra<NewHeap<8>>(g, 0, dist);}, [&] {return operations<NewHeap<8>>(n, values, keys);});
+    printf("(checksum %.0f)\n", checksum);
+}
@@ -0,0 +1,70 @@
+// Benchmark of the coordinate searches: airports within a radius of many random locations, checking every airport
+// with Graph::distance the way Supervisor::localAirports used to, against the k-d tree of SpatialIndex, and the
+// nearest airports of each location with the k-d tree.
+//
+// Run from the build directory (the data is read from ../data/).
+// Usage: spatialBench [locations] [radius in km] [nearest]
+// (configure with -DCMAKE_BUILD_TYPE=Release, unoptimized builds are about ten times slower)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../classes/supervisor.h"
+
+using namespace std;
+
+static double elapsed(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int locations = argc > 1 ? atoi(argv[1]) : 10000;
+    double radius = argc > 2 ? atof(argv[2]) : 300;
+    int k = argc > 3 ? atoi(argv[3]) : 5;
+
+    Supervisor supervisor;
+    const Graph& graph = supervisor.getGraph();
+    int n = graph.getSize();
+
+    mt19937 rng(2023);
+    uniform_real_distribution<double> latitude(-60, 70), longitude(-180, 180);
+    vector<pair<double, double>> queries(locations);
+    for (auto& q : queries) q = {latitude(rng), longitude(rng)};
+
+    auto start = chrono::steady_clock::now();
+    long scanned = 0;
+    for (const auto& [lat, lon] : queries)
+        for (int v = 1; v <= n; v++) {
+            const Airport& airport = graph.getAirport(v);
+            if (Graph::distance(lat, lon, airport.getLatitude(), airport.getLongitude()) <= radius) scanned++;
+        }
+    double scanSeconds = elapsed(start);
+
+    start = chrono::steady_clock::now();
+    SpatialIndex index(graph);
+    double buildSeconds = elapsed(start);
+
+    start = chrono::steady_clock::now();
+    long found = 0;
+    for (const auto& [lat, lon] : queries)
+        found += (long) index.withinRadius(lat, lon, radius).size();
+    double treeSeconds = elapsed(start);
+
+    start = chrono::steady_clock::now();
+    double nearestKm = 0;
+    for (const auto& [lat, lon] : queries)
+        nearestKm += index.nearest(lat, lon, k).front().second;
+    double nearestSeconds = elapsed(start);
+
+    printf("%d airports, %d locations, radius %.0f km\n", n, locations, radius);
+    printf("  every airport  %8.1f ms  (%ld found)\n", scanSeconds * 1000, scanned);
+    printf("  k-d tree       %8.1f ms  (%ld found, built in %.2f ms)\n", treeSeconds * 1000, found, buildSeconds * 1000);
+    printf("  %d nearest      %8.1f ms  (nearest airport %.1f km away on average)\n", k, nearestSeconds * 1000,
+           nearestKm / locations);
+    if (scanned != found) {
+        printf("results differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -12,8 +12,9 @@ Airline::Airline(string code){
 }
 
 string Airline::getCode() const {return this->code;}
-string Airline::getName(){return this->name;}
-string Airline::getCountry(){return this->country;}
+string Airline::getName() const {return this->name;}
+string Airline::getCallSign() const {return this->callSign;}
+string Airline::getCountry() const {return this->country;}
 
 
 
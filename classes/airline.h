@@ -29,8 +29,9 @@ public:
     };
 
     string getCode() const;
-    string getName();
-    string getCountry();
+    string getName() const;
+    string getCallSign() const;
+    string getCountry() const;
     typedef unordered_set<Airline,Airline::AirlineHash,Airline::AirlineHash> AirlineH;
 private:
     string code;
@@ -0,0 +1,50 @@
+#ifndef AIRLINEMASK_H
+#define AIRLINEMASK_H
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// Airline filter compiled into a bitset over the dense airline ids, tested once per edge visit
+class AirlineMask {
+    vector<uint64_t> bits;
+    bool all = true;           // no airlines chosen: every airline is accepted
+
+public:
+    AirlineMask() = default;                      // Create a filter that accepts every airline
+    explicit AirlineMask(int nrAirlines);         // Create a filter that accepts no airline (yet)
+    void set(int id);                             // Accept the airline with this id
+    bool accepts(int id) const;                   // Is the airline with this id accepted?
+    template <class Range>
+    bool acceptsAny(const Range& ids) const;      // Is any airline of the range accepted?
+    bool acceptsAll() const;                      // Is every airline accepted?
+};
+
+// ----------------------------------------------
+
+inline AirlineMask::AirlineMask(int nrAirlines) : bits((nrAirlines + 63) / 64, 0), all(false) {
+}
+
+inline void AirlineMask::set(int id) {
+    if (id < 0 || id >= (int) bits.size() * 64) return;
+    bits[id >> 6] |= (uint64_t) 1 << (id & 63);
+}
+
+inline bool AirlineMask::accepts(int id) const {
+    return all || (bits[id >> 6] >> (id & 63)) & 1;
+}
+
+template <class Range>
+inline bool AirlineMask::acceptsAny(const Range& ids) const {
+    if (all) return true;
+    for (int id : ids)
+        if ((bits[id >> 6] >> (id & 63)) & 1) return true;
+    return false;
+}
+
+inline bool AirlineMask::acceptsAll() const {
+    return all;
+}
+
+#endif //AIRLINEMASK_H
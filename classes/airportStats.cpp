@@ -0,0 +1,67 @@
+#include "airportStats.h"
+
+/**
+ * Counts the departures and the distinct airlines of every airport and ranks the airports by both\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|E| + f + |V|*log(|V|))</b>, V -> number of nodes, E -> number of edges, f -> number of flights
+ * </pre>
+ * @param graph - loaded graph
+ */
+AirportStats::AirportStats(const Graph& graph) : nrFlights(graph.getSize()+1, 0), nrAirlines(graph.getSize()+1, 0) {
+    vector<int> seen(graph.nrAirlines(), 0);   // last node each airline was counted for
+    for (int v = 1; v <= graph.getSize(); v++) {
+        nrFlights[v] = graph.departures(v);
+        for (const auto& e : graph.adj(v))
+            for (int airline : graph.airlinesOf(e))
+                if (seen[airline] != v) {
+                    seen[airline] = v;
+                    nrAirlines[v]++;
+                }
+    }
+    byFlights = rank(graph, nrFlights);
+    byAirlines = rank(graph, nrAirlines);
+}
+
+int AirportStats::flights(int v) const {return nrFlights[v];}
+int AirportStats::airlines(int v) const {return nrAirlines[v];}
+
+const vector<pair<int, string>>& AirportStats::ranking(Criterion criterion) const {
+    return criterion == FLIGHTS ? byFlights : byAirlines;
+}
+
+/**
+ * Reads a top from the ranking\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(k)</b>
+ * </pre>
+ * @param criterion - count to rank the airports by
+ * @param k - number of airports
+ * @return the k airports with the highest count (all of them if there are fewer), as (count, code)
+ */
+vector<pair<int, string>> AirportStats::top(Criterion criterion, int k) const {
+    const auto& res = ranking(criterion);
+    return {res.begin(), res.begin() + max(0, min(k, (int) res.size()))};
+}
+
+/**
+ * Sorts the airports by a count, highest first, breaking ties by code\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|*log(|V|))</b>, V -> number of nodes
+ * </pre>
+ * @param graph - loaded graph
+ * @param counts - count of each node
+ * @return (count, code) of every airport, highest count first
+ */
+vector<pair<int, string>> AirportStats::rank(const Graph& graph, const vector<int>& counts) {
+    vector<pair<int, string>> res;
+    res.reserve(graph.getSize());
+    for (int v = 1; v <= graph.getSize(); v++)
+        res.emplace_back(counts[v], graph.getAirport(v).getCode());
+    sort(res.begin(), res.end(), [](const pair<int, string>& a, const pair<int, string>& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    return res;
+}
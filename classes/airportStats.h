@@ -0,0 +1,34 @@
+#ifndef AIRPORTSTATS_H
+#define AIRPORTSTATS_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "graph.h"
+
+using namespace std;
+
+// Number of flights (departures) and of distinct airlines of every airport, counted once when the network is loaded,
+// with the airports ranked by each of them so that any top is read straight from the ranking
+class AirportStats {
+public:
+    enum Criterion {FLIGHTS, AIRLINES};
+
+    AirportStats() = default;
+    explicit AirportStats(const Graph& graph);
+
+    int flights(int v) const;
+    int airlines(int v) const;
+    const vector<pair<int, string>>& ranking(Criterion criterion) const;   // (count, code), highest first
+    vector<pair<int, string>> top(Criterion criterion, int k) const;       // first k of the ranking
+
+private:
+    static vector<pair<int, string>> rank(const Graph& graph, const vector<int>& counts);
+
+    vector<int> nrFlights;      // departures of each node
+    vector<int> nrAirlines;     // distinct airlines departing from each node
+    vector<pair<int, string>> byFlights;
+    vector<pair<int, string>> byAirlines;
+};
+
+#endif //AIRPORTSTATS_H
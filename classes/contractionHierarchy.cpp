@@ -0,0 +1,492 @@
+#include "contractionHierarchy.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#define HIERARCHY_MAGIC "RENAIRCH"
+#define HIERARCHY_VERSION 2
+#define WITNESS_SETTLED 500
+
+typedef ContractionHierarchy::Arc Arc;
+
+// Working graph of the contraction: arcs between the nodes that are still to be contracted plus the shortcuts added
+class Contractor {
+public:
+    explicit Contractor(const Graph& graph) : out(graph.getSize()+1), in(graph.getSize()+1),
+                                              contracted(graph.getSize()+1, false), deleted(graph.getSize()+1, 0),
+                                              dist(graph.getSize()+1, INF), isTarget(graph.getSize()+1, 0),
+                                              direct(graph.getSize()+1, 0), queue(graph.getSize()+1) {
+        for (int u = 1; u <= graph.getSize(); u++)
+            for (const auto& e : graph.adj(u))
+                if (e.dest != u) addArc(u, e.dest, -1, e.distance);
+    }
+
+    // Adds the arc u -> x, or lowers the weight of the existing one
+    void addArc(int u, int x, int middle, double weight) {
+        for (auto& a : out[u])
+            if (a.target == x) {
+                if (weight >= a.weight) return;
+                a = {x, middle, weight};
+                for (auto& b : in[x])
+                    if (b.target == u) b = {u, middle, weight};
+                return;
+            }
+        out[u].push_back({x, middle, weight});
+        in[x].push_back({u, middle, weight});
+    }
+
+    // Settles the remaining nodes (except via) closer to src than limit, stopping once the targets of the
+    // contraction are settled or after WITNESS_SETTLED nodes
+    void witness(int src, int via, double limit, int targets) {
+        for (int v : touched) dist[v] = INF;
+        touched.assign(1, src);
+        dist[src] = 0;
+        queue.clear();
+        queue.insert(src, 0);
+        int settled = 0;
+        while (!queue.empty() && settled < WITNESS_SETTLED && targets > 0) {
+            int u = queue.removeMin();
+            double d = dist[u];
+            if (d > limit) break;
+            settled++;
+            if (isTarget[u] == round) targets--;
+            for (const auto& a : out[u]) {
+                int x = a.target;
+                if (x == via || d + a.weight >= dist[x]) continue;
+                if (dist[x] == INF) touched.push_back(x);
+                dist[x] = d + a.weight;
+                queue.push(x, dist[x]);
+            }
+        }
+    }
+
+    // Finds the shortcuts needed to contract v and leaves them in shortcuts. A pair u -> v -> x needs no witness
+    // search when u already has an arc to x that is as short
+    int contract(int v) {
+        shortcuts.clear();
+        for (size_t i = 0; i < in[v].size(); i++) {
+            Arc a = in[v][i];
+            int u = a.target;
+
+            round++;
+            for (const auto& c : out[u]) {
+                isTarget[c.target] = round;
+                direct[c.target] = c.weight;
+            }
+            double limit = -1;
+            int targets = 0;
+            round++;
+            for (const auto& b : out[v]) {
+                int x = b.target;
+                if (x == u) continue;
+                bool covered = isTarget[x] == round - 1 && direct[x] <= a.weight + b.weight;
+                isTarget[x] = covered ? round - 1 : round;
+                if (covered) continue;
+                limit = max(limit, a.weight + b.weight);
+                targets++;
+            }
+            if (targets == 0) continue;
+
+            witness(u, v, limit, targets);
+            for (size_t j = 0; j < out[v].size(); j++) {
+                Arc b = out[v][j];
+                int x = b.target;
+                if (isTarget[x] != round || dist[x] <= a.weight + b.weight) continue;
+                shortcuts.push_back({u, {x, v, a.weight + b.weight}});
+            }
+        }
+        return (int) shortcuts.size();
+    }
+
+    // Edge difference of contracting v (counted twice), plus how many of its neighbours are already contracted
+    int priority(int v) {
+        return 2 * (contract(v) - (int) (in[v].size() + out[v].size())) + deleted[v];
+    }
+
+    // Contracts v, whose shortcuts were just found by priority(v): adds them, then moves the arcs of v out of the
+    // working graph into the hierarchy
+    void remove(int v) {
+        for (const auto& [u, a] : shortcuts)
+            addArc(u, a.target, a.middle, a.weight);
+        contracted[v] = true;
+        for (const auto& a : in[v]) {
+            finished.push_back({a.target, {v, a.middle, a.weight}});
+            detach(out[a.target], v);
+            deleted[a.target]++;
+        }
+        for (const auto& a : out[v]) {
+            finished.push_back({v, a});
+            detach(in[a.target], v);
+            deleted[a.target]++;
+        }
+        in[v].clear();
+        out[v].clear();
+    }
+
+    static void detach(vector<Arc>& arcs, int v) {
+        for (size_t i = 0; i < arcs.size(); i++)
+            if (arcs[i].target == v) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+    }
+
+    vector<vector<Arc>> out, in;       // arcs between nodes that are not contracted yet
+    vector<pair<int, Arc>> finished;   // arcs (source, arc) with a contracted end, final
+    vector<pair<int, Arc>> shortcuts;  // shortcuts (source, arc) found by the last call to contract
+    vector<bool> contracted;
+    vector<int> deleted;
+    vector<double> dist;
+    vector<int> touched;
+    vector<int> isTarget;     // round in which each node was last a target of a witness search
+    vector<double> direct;    // weight of the arc from the source of the current witness search, if any
+    DAryHeap<double> queue;   // priority queue of the witness searches
+    int round = 0;
+};
+
+ContractionHierarchy::ContractionHierarchy(int size) : size(size), rank(size+1, 0) {}
+
+/**
+ * Contracts every node of the graph, least important first (by edge difference, updated lazily), and keeps the
+ * routes and shortcuts as the upward and downward arcs the queries run on. Shortcuts are only added when a
+ * bounded witness search finds no path that is as short without the contracted node\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| * d² * w)</b>, V -> number of nodes, d -> degree of a node when it is contracted, w -> cost of a witness search
+ * </pre>
+ * @param graph - loaded graph
+ * @return the hierarchy
+ */
+shared_ptr<ContractionHierarchy> ContractionHierarchy::build(const Graph& graph) {
+    int n = graph.getSize();
+    shared_ptr<ContractionHierarchy> ch(new ContractionHierarchy(n));
+    Contractor c(graph);
+
+    DAryHeap<int> order(n+1);
+    for (int v = 1; v <= n; v++)
+        order.insert(v, c.priority(v));
+
+    int next = 0;
+    while (!order.empty()) {
+        int v = order.removeMin();
+        int p = c.priority(v);
+        if (!order.empty() && p > order.topValue()) {
+            order.insert(v, p);
+            continue;
+        }
+        c.remove(v);
+        ch->rank[v] = ++next;
+    }
+
+    ch->pack(c.finished);
+    return ch;
+}
+
+// Splits the arcs (source, arc) of the contracted graph into the upward arcs of each node and the downward arcs into each node
+void ContractionHierarchy::pack(const vector<pair<int, Arc>>& arcs) {
+    upOffsets.assign(size+2, 0);
+    downOffsets.assign(size+2, 0);
+    for (const auto& [u, a] : arcs) {
+        if (rank[a.target] > rank[u]) upOffsets[u+1]++;
+        else downOffsets[a.target+1]++;
+    }
+    for (int v = 1; v <= size; v++) {
+        upOffsets[v+1] += upOffsets[v];
+        downOffsets[v+1] += downOffsets[v];
+    }
+
+    up.resize(upOffsets[size+1]);
+    down.resize(downOffsets[size+1]);
+    vector<int> nextUp(upOffsets), nextDown(downOffsets);
+    for (const auto& [u, a] : arcs) {
+        if (rank[a.target] > rank[u]) up[nextUp[u]++] = a;
+        else down[nextDown[a.target]++] = {u, a.middle, a.weight};
+    }
+}
+
+namespace {
+    struct HierarchyHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t nrNodes, nrUp, nrDown;
+        DataStamp stamp;
+    };
+}
+
+/**
+ * Reads a hierarchy written by write() and checks that it is complete, of the current version, built from the
+ * current CSV files and consistent (see valid)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + a)</b>, V -> number of nodes, a -> number of arcs
+ * </pre>
+ * @param path - path of the file
+ * @param stamp - stamp of the CSV files the hierarchy must have been built from
+ * @param nrNodes - number of nodes of the graph
+ * @return the hierarchy, or nullptr if it is missing, corrupt or stale
+ */
+shared_ptr<ContractionHierarchy> ContractionHierarchy::open(const string& path, const DataStamp& stamp, int nrNodes) {
+    ifstream in(path, ios::binary);
+    if (!in) return nullptr;
+
+    HierarchyHeader header{};
+    in.read((char*) &header, sizeof(header));
+    if (!in || memcmp(header.magic, HIERARCHY_MAGIC, 8) != 0 || header.version != HIERARCHY_VERSION) return nullptr;
+    if (!(header.stamp == stamp) || (int) header.nrNodes != nrNodes) return nullptr;
+
+    shared_ptr<ContractionHierarchy> ch(new ContractionHierarchy(nrNodes));
+    ch->upOffsets.resize(nrNodes+2);
+    ch->downOffsets.resize(nrNodes+2);
+    ch->up.resize(header.nrUp);
+    ch->down.resize(header.nrDown);
+    in.read((char*) ch->rank.data(), ch->rank.size() * sizeof(int));
+    in.read((char*) ch->upOffsets.data(), ch->upOffsets.size() * sizeof(int));
+    in.read((char*) ch->up.data(), ch->up.size() * sizeof(Arc));
+    in.read((char*) ch->downOffsets.data(), ch->downOffsets.size() * sizeof(int));
+    in.read((char*) ch->down.data(), ch->down.size() * sizeof(Arc));
+    if (!in || in.peek() != EOF || !ch->valid()) return nullptr;
+    return ch;
+}
+
+/**
+ * Checks the arrays read from a file before any query follows them: the ranks are a permutation of 1..|V| and
+ * the arcs of both directions are in range (see validArcs). A damaged file whose stamp still matches is then
+ * rebuilt instead of being read out of bounds\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + a)</b>, V -> number of nodes, a -> number of arcs
+ * </pre>
+ * @return true if the hierarchy can be queried safely
+ */
+bool ContractionHierarchy::valid() const {
+    vector<bool> seen(size+1, false);
+    for (int v = 1; v <= size; v++) {
+        if (rank[v] < 1 || rank[v] > size || seen[rank[v]]) return false;
+        seen[rank[v]] = true;
+    }
+    return validArcs(upOffsets, up) && validArcs(downOffsets, down);
+}
+
+/**
+ * Checks one direction of the arcs. The offsets must never decrease and must end at the number of arcs. Every
+ * arc must lead to a node ranked above the one it is stored under, with a weight that is a distance. Every
+ * shortcut must bypass a node ranked below both of its ends, so unpacking always ends\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + a)</b>, V -> number of nodes, a -> number of arcs
+ * </pre>
+ * @param offsets - offsets of the arcs of each node (upOffsets or downOffsets)
+ * @param arcs - the arcs (up or down)
+ * @return true if every offset and arc is in range
+ */
+bool ContractionHierarchy::validArcs(const vector<int>& offsets, const vector<Arc>& arcs) const {
+    if (offsets[0] < 0 || offsets[size+1] != (int) arcs.size()) return false;
+    for (int v = 0; v <= size; v++)
+        if (offsets[v] > offsets[v+1]) return false;
+    for (int v = 1; v <= size; v++)
+        for (int i = offsets[v]; i < offsets[v+1]; i++) {
+            const Arc& a = arcs[i];
+            if (a.target < 1 || a.target > size || rank[a.target] <= rank[v] || !(a.weight >= 0)) return false;
+            if (a.middle != -1 && (a.middle < 1 || a.middle > size || rank[a.middle] >= rank[v])) return false;
+        }
+    return true;
+}
+
+/**
+ * Writes the hierarchy next to its final path and then renames it, so a reader never sees a half-written file\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + a)</b>, V -> number of nodes, a -> number of arcs
+ * </pre>
+ * @param path - path of the file
+ * @param stamp - stamp of the CSV files the graph was built from
+ * @return true if the file was written
+ */
+bool ContractionHierarchy::write(const string& path, const DataStamp& stamp) const {
+    HierarchyHeader header{};
+    memcpy(header.magic, HIERARCHY_MAGIC, 8);
+    header.version = HIERARCHY_VERSION;
+    header.nrNodes = size;
+    header.nrUp = up.size();
+    header.nrDown = down.size();
+    header.stamp = stamp;
+
+    string tmp = path + ".tmp";
+    ofstream out(tmp, ios::binary | ios::trunc);
+    if (!out) return false;
+    out.write((const char*) &header, sizeof(header));
+    out.write((const char*) rank.data(), rank.size() * sizeof(int));
+    out.write((const char*) upOffsets.data(), upOffsets.size() * sizeof(int));
+    out.write((const char*) up.data(), up.size() * sizeof(Arc));
+    out.write((const char*) downOffsets.data(), downOffsets.size() * sizeof(int));
+    out.write((const char*) down.data(), down.size() * sizeof(Arc));
+    out.close();
+    if (!out) {
+        remove(tmp.c_str());
+        return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @return number of arcs that bypass a contracted node
+ */
+int ContractionHierarchy::nrShortcuts() const {
+    int count = 0;
+    for (const auto& a : up) count += a.middle != -1;
+    for (const auto& a : down) count += a.middle != -1;
+    return count;
+}
+
+/**
+ * Runs a Dijkstra upwards from src and one upwards (over the reversed arcs) from dest, alternating between them.
+ * Each side stops once its closest unsettled node is no closer than the best meeting found so far\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(s*log(s))</b>, s -> nodes above src and dest in the hierarchy
+ * </pre>
+ * @param src - source node
+ * @param dest - target node
+ * @param ws - search workspace that holds the traversal state
+ * @param meeting - node where the best upward paths meet, -1 if dest is unreachable
+ * @return minimum flown distance between src and dest, INF if unreachable
+ */
+double ContractionHierarchy::search(int src, int dest, SearchWorkspace& ws, int& meeting) const {
+    ws.hierarchy.resize(size+1);
+    SearchWorkspace::Hierarchy& state = ws.hierarchy;
+    DAryHeap<double>& forwards = state.forwardQueue;
+    DAryHeap<double>& backwards = state.backwardQueue;
+    forwards.clear();
+    backwards.clear();
+    state.forwardDistance[src] = 0;
+    state.backwardDistance[dest] = 0;
+    state.previous[src] = -1;
+    state.next[dest] = -1;
+    state.touched.assign({src, dest});
+    forwards.insert(src, 0);
+    backwards.insert(dest, 0);
+
+    double best = INF;
+    meeting = -1;
+    bool forwardsOn = true, backwardsOn = true, turn = true;
+
+    while (forwardsOn || backwardsOn) {
+        bool isForwards = (turn && forwardsOn) || !backwardsOn;
+        turn = !turn;
+        DAryHeap<double>& q = isForwards ? forwards : backwards;
+        vector<double>& dist = isForwards ? state.forwardDistance : state.backwardDistance;
+        const vector<double>& other = isForwards ? state.backwardDistance : state.forwardDistance;
+        vector<int>& parent = isForwards ? state.previous : state.next;
+        bool& on = isForwards ? forwardsOn : backwardsOn;
+
+        if (q.getSize() == 0) {
+            on = false;
+            continue;
+        }
+        int u = q.removeMin();
+        if (dist[u] >= best) {
+            on = false;
+            continue;
+        }
+        if (other[u] < INF && dist[u] + other[u] < best) {
+            best = dist[u] + other[u];
+            meeting = u;
+        }
+
+        // stall u if a higher node already reaches it by a shorter path: its upward arcs cannot be on a shortest path
+        const vector<int>& opposite = isForwards ? downOffsets : upOffsets;
+        const vector<Arc>& reversed = isForwards ? down : up;
+        bool stalled = false;
+        for (int i = opposite[u]; i < opposite[u+1] && !stalled; i++)
+            stalled = dist[reversed[i].target] + reversed[i].weight < dist[u];
+        if (stalled) continue;
+
+        const vector<int>& offsets = isForwards ? upOffsets : downOffsets;
+        const vector<Arc>& arcs = isForwards ? up : down;
+        for (int i = offsets[u]; i < offsets[u+1]; i++) {
+            int v = arcs[i].target;
+            double d = dist[u] + arcs[i].weight;
+            if (d >= dist[v]) continue;
+            if (state.forwardDistance[v] == INF && state.backwardDistance[v] == INF) state.touched.push_back(v);
+            dist[v] = d;
+            parent[v] = u;
+            q.push(v, d);
+        }
+    }
+
+    for (int v : state.touched)
+        state.forwardDistance[v] = state.backwardDistance[v] = INF;
+    return best;
+}
+
+/**
+ * Calculates the minimum flown distance between two airports using every airline\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(s*log(s))</b>, s -> nodes above src and dest in the hierarchy
+ * </pre>
+ * @param src - source node
+ * @param dest - target node
+ * @param ws - search workspace that holds the traversal state
+ * @return minimum flown distance between src and dest, INF if unreachable
+ */
+double ContractionHierarchy::distance(int src, int dest, SearchWorkspace& ws) const {
+    int meeting;
+    return search(src, dest, ws, meeting);
+}
+
+// Finds the arc u -> v kept by the hierarchy, stored with whichever end has the lower rank
+const Arc* ContractionHierarchy::findArc(int u, int v) const {
+    if (rank[u] < rank[v]) {
+        for (int i = upOffsets[u]; i < upOffsets[u+1]; i++)
+            if (up[i].target == v) return &up[i];
+    }
+    else {
+        for (int i = downOffsets[v]; i < downOffsets[v+1]; i++)
+            if (down[i].target == u) return &down[i];
+    }
+    return nullptr;
+}
+
+// Appends the nodes after u on the route the arc u -> v stands for, replacing every shortcut by its two halves
+void ContractionHierarchy::unpack(int u, int v, vector<int>& path) const {
+    const Arc* arc = findArc(u, v);
+    if (arc == nullptr || arc->middle == -1) {
+        path.push_back(v);
+        return;
+    }
+    int middle = arc->middle;
+    unpack(u, middle, path);
+    unpack(middle, v, path);
+}
+
+/**
+ * Calculates the path with the minimum flown distance between two airports using every airline, as the sequence of
+ * airports it goes through (shortcuts unpacked)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(s*log(s) + p*d)</b>, s -> nodes above src and dest in the hierarchy, p -> length of the path, d -> arcs of a node
+ * </pre>
+ * @param src - source node
+ * @param dest - target node
+ * @param ws - search workspace that holds the traversal state
+ * @return path as a sequence of nodes from src to dest (empty if there is none)
+ */
+vector<int> ContractionHierarchy::path(int src, int dest, SearchWorkspace& ws) const {
+    SearchWorkspace::Hierarchy& state = ws.hierarchy;
+    int meeting;
+    if (search(src, dest, ws, meeting) >= INF) return {};
+
+    vector<int> upwards;
+    for (int v = meeting; v != -1; v = state.previous[v])
+        upwards.push_back(v);
+    reverse(upwards.begin(), upwards.end());
+
+    vector<int> path = {src};
+    for (size_t i = 0; i + 1 < upwards.size(); i++)
+        unpack(upwards[i], upwards[i+1], path);
+    for (int v = meeting; state.next[v] != -1; v = state.next[v])
+        unpack(v, state.next[v], path);
+    return path;
+}
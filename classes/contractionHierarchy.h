@@ -0,0 +1,48 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "graph.h"
+#include "snapshot.h"
+
+using namespace std;
+
+// Contraction hierarchy over the distance-weighted routes of the network (every airline allowed). Nodes are
+// contracted one at a time, adding shortcuts that keep their shortest paths, so a query only has to search upwards
+// from both ends. Built once and written to a file stamped with the CSV files it came from
+class ContractionHierarchy {
+public:
+    struct Arc {
+        int target;       // other end of the arc
+        int middle;       // node bypassed by a shortcut, -1 for a route of the graph
+        double weight;    // flown distance
+    };
+
+    static shared_ptr<ContractionHierarchy> build(const Graph& graph);
+    static shared_ptr<ContractionHierarchy> open(const string& path, const DataStamp& stamp, int nrNodes);
+    bool write(const string& path, const DataStamp& stamp) const;
+
+    double distance(int src, int dest, SearchWorkspace& ws) const;      // INF if unreachable
+    vector<int> path(int src, int dest, SearchWorkspace& ws) const;     // nodes from src to dest, empty if unreachable
+    int nrShortcuts() const;
+
+private:
+    explicit ContractionHierarchy(int size);
+    void pack(const vector<pair<int, Arc>>& arcs);
+    bool valid() const;
+    bool validArcs(const vector<int>& offsets, const vector<Arc>& arcs) const;
+    double search(int src, int dest, SearchWorkspace& ws, int& meeting) const;
+    const Arc* findArc(int u, int v) const;
+    void unpack(int u, int v, vector<int>& path) const;
+
+    int size;
+    vector<int> rank;          // contraction order of each node
+    vector<int> upOffsets;     // arcs from node v to higher ranked nodes are up[upOffsets[v]] .. up[upOffsets[v+1]-1]
+    vector<Arc> up;
+    vector<int> downOffsets;   // arcs into node v from higher ranked nodes (target is where the arc leaves from)
+    vector<Arc> down;
+};
+
+#endif //CONTRACTIONHIERARCHY_H
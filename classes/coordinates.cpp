@@ -0,0 +1,244 @@
+#include "coordinates.h"
+#include <cmath>
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define COORDINATES_AVX2
+#endif
+
+#define ASIN_TERMS 24    // terms of the arcsine series, enough for full precision up to sin(30º)
+
+namespace {
+    // Taylor coefficients of asin(t) = t * (c[0] + c[1]*t² + c[2]*t⁴ + ...)
+    struct AsinSeries {
+        double c[ASIN_TERMS];
+        AsinSeries() {
+            c[0] = 1;
+            for (int n = 0; n + 1 < ASIN_TERMS; n++)
+                c[n+1] = c[n] * (2*n+1) * (2*n+1) / ((2*n+2) * (2.0*n+3));
+        }
+    };
+    const AsinSeries series;
+
+    // Great-circle distance in km between two unit vectors whose chord is sqrt(c2). Half the central angle is
+    // asin(chord/2); above sin(30º) it is taken from the complement so that the series always converges fast.
+    // The AVX2 version below performs the same operations in the same order
+    double chordToKm(double c2) {
+        double s = min(sqrt(c2) * 0.5, 1.0);
+        bool far = s > 0.5;
+        double t = far ? sqrt((1 - s) * 0.5) : s;
+        double t2 = t * t, p = series.c[ASIN_TERMS-1];
+        for (int i = ASIN_TERMS - 2; i >= 0; i--)
+            p = p * t2 + series.c[i];
+        double half = t * p;
+        if (far) half = M_PI_2 - 2 * half;
+        return 2 * EARTH_RADIUS * half;
+    }
+
+    double chord2(double dx, double dy, double dz) {
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+#ifdef COORDINATES_AVX2
+    __attribute__((target("avx2")))
+    inline __m256d chordToKm(__m256d c2) {
+        __m256d one = _mm256_set1_pd(1.0), half = _mm256_set1_pd(0.5);
+        __m256d s = _mm256_min_pd(_mm256_mul_pd(_mm256_sqrt_pd(c2), half), one);
+        __m256d far = _mm256_cmp_pd(s, half, _CMP_GT_OQ);
+        __m256d t = _mm256_blendv_pd(s, _mm256_sqrt_pd(_mm256_mul_pd(_mm256_sub_pd(one, s), half)), far);
+        __m256d t2 = _mm256_mul_pd(t, t), p = _mm256_set1_pd(series.c[ASIN_TERMS-1]);
+        for (int i = ASIN_TERMS - 2; i >= 0; i--)
+            p = _mm256_add_pd(_mm256_mul_pd(p, t2), _mm256_set1_pd(series.c[i]));
+        __m256d angle = _mm256_mul_pd(t, p);
+        __m256d complement = _mm256_sub_pd(_mm256_set1_pd(M_PI_2), _mm256_mul_pd(_mm256_set1_pd(2.0), angle));
+        angle = _mm256_blendv_pd(angle, complement, far);
+        return _mm256_mul_pd(_mm256_set1_pd(2 * EARTH_RADIUS), angle);
+    }
+
+    // Gathers base[idx[0..3]], starting from zeros so that no uninitialized source operand is passed
+    __attribute__((target("avx2")))
+    inline __m256d gather(const double* base, __m128i idx) {
+        __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, all, 8);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256d chord2(__m256d dx, __m256d dy, __m256d dz) {
+        return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+    }
+
+    // Distances from (px, py, pz) to points[0 .. n-1], four at a time; returns how many were computed
+    __attribute__((target("avx2")))
+    int distancesAvx2(const double* x, const double* y, const double* z, double px, double py, double pz,
+                      const int* points, int n, double* res) {
+        __m256d vx = _mm256_set1_pd(px), vy = _mm256_set1_pd(py), vz = _mm256_set1_pd(pz);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i idx = _mm_loadu_si128((const __m128i*) (points + i));
+            __m256d dx = _mm256_sub_pd(gather(x, idx), vx);
+            __m256d dy = _mm256_sub_pd(gather(y, idx), vy);
+            __m256d dz = _mm256_sub_pd(gather(z, idx), vz);
+            _mm256_storeu_pd(res + i, chordToKm(chord2(dx, dy, dz)));
+        }
+        return i;
+    }
+
+    // Distances between src[i] and dest[i] for i in 0 .. n-1, four at a time; returns how many were computed
+    __attribute__((target("avx2")))
+    int pairsAvx2(const double* x, const double* y, const double* z, const int* src, const int* dest, int n,
+                  double* res) {
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i from = _mm_loadu_si128((const __m128i*) (src + i));
+            __m128i to = _mm_loadu_si128((const __m128i*) (dest + i));
+            __m256d dx = _mm256_sub_pd(gather(x, to), gather(x, from));
+            __m256d dy = _mm256_sub_pd(gather(y, to), gather(y, from));
+            __m256d dz = _mm256_sub_pd(gather(z, to), gather(z, from));
+            _mm256_storeu_pd(res + i, chordToKm(chord2(dx, dy, dz)));
+        }
+        return i;
+    }
+#endif
+}
+
+/**
+ * Coordinates class constructor, with room for points 0 .. size-1
+ * @param size - number of points
+ */
+Coordinates::Coordinates(int size) : x(size, 0), y(size, 0), z(size, 0) {}
+
+int Coordinates::getSize() const {return (int) x.size();}
+
+/**
+ * @return true if the CPU supports AVX2, so that the batch kernels compute four distances at a time
+ */
+bool Coordinates::vectorized() {
+#ifdef COORDINATES_AVX2
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @param latitude - latitude in degrees
+ * @param longitude - longitude in degrees
+ * @param x, y, z - receive the unit vector of the point at those coordinates
+ */
+void Coordinates::unitVector(double latitude, double longitude, double& x, double& y, double& z) {
+    double lat = latitude * M_PI / 180.0, lon = longitude * M_PI / 180.0;
+    x = cos(lat) * cos(lon);
+    y = cos(lat) * sin(lon);
+    z = sin(lat);
+}
+
+/**
+ * Stores the position of a point
+ * @param i - point
+ * @param latitude - latitude in degrees
+ * @param longitude - longitude in degrees
+ */
+void Coordinates::set(int i, double latitude, double longitude) {
+    unitVector(latitude, longitude, x[i], y[i], z[i]);
+}
+
+/**
+ * Calculates the distance between two points on a sphere using their latitudes and longitudes measured along the
+ * surface, with the haversine formula and the arcsine of the C library (which differs from the series of the stored
+ * points by less than 1e-11 km)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param lat1 - latitude of point 1
+ * @param lon1 - longitude of point 1
+ * @param lat2 - latitude of point 2
+ * @param lon2 - longitude of point 2
+ * @return distance between the two points, in km
+ */
+double Coordinates::distance(double lat1, double lon1, double lat2, double lon2) {
+    double sinLat = sin((lat2 - lat1) * M_PI / 360.0), sinLon = sin((lon2 - lon1) * M_PI / 360.0);
+    double a = sinLat * sinLat + sinLon * sinLon * cos(lat1 * M_PI / 180.0) * cos(lat2 * M_PI / 180.0);
+    return 2 * EARTH_RADIUS * asin(min(sqrt(a), 1.0));
+}
+
+/**
+ * @param a - point
+ * @param b - point
+ * @return distance between two stored points, in km (the same value the batch kernels give)
+ */
+double Coordinates::distance(int a, int b) const {
+    return chordToKm(chord2(x[b] - x[a], y[b] - y[a], z[b] - z[a]));
+}
+
+/**
+ * Calculates the distances from a position to many stored points\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>
+ * </pre>
+ * @param latitude - latitude of the position, in degrees
+ * @param longitude - longitude of the position, in degrees
+ * @param points - stored points
+ * @param n - number of points
+ * @param res - receives the distance to each point, in km
+ */
+void Coordinates::distances(double latitude, double longitude, const int* points, int n, double* res) const {
+    double px, py, pz;
+    unitVector(latitude, longitude, px, py, pz);
+    int i = 0;
+#ifdef COORDINATES_AVX2
+    if (vectorized()) i = distancesAvx2(x.data(), y.data(), z.data(), px, py, pz, points, n, res);
+#endif
+    for (; i < n; i++) {
+        int p = points[i];
+        res[i] = chordToKm(chord2(x[p] - px, y[p] - py, z[p] - pz));
+    }
+}
+
+/**
+ * Calculates the distances from a stored point to many others\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>
+ * </pre>
+ * @param src - stored point
+ * @param points - stored points
+ * @param n - number of points
+ * @param res - receives the distance to each point, in km
+ */
+void Coordinates::distances(int src, const int* points, int n, double* res) const {
+    double px = x[src], py = y[src], pz = z[src];
+    int i = 0;
+#ifdef COORDINATES_AVX2
+    if (vectorized()) i = distancesAvx2(x.data(), y.data(), z.data(), px, py, pz, points, n, res);
+#endif
+    for (; i < n; i++) {
+        int p = points[i];
+        res[i] = chordToKm(chord2(x[p] - px, y[p] - py, z[p] - pz));
+    }
+}
+
+/**
+ * Calculates the distances between many pairs of stored points\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>
+ * </pre>
+ * @param src - first point of each pair
+ * @param dest - second point of each pair
+ * @param n - number of pairs
+ * @param res - receives the distance of each pair, in km
+ */
+void Coordinates::distances(const int* src, const int* dest, int n, double* res) const {
+    int i = 0;
+#ifdef COORDINATES_AVX2
+    if (vectorized()) i = pairsAvx2(x.data(), y.data(), z.data(), src, dest, n, res);
+#endif
+    for (; i < n; i++) {
+        int a = src[i], b = dest[i];
+        res[i] = chordToKm(chord2(x[b] - x[a], y[b] - y[a], z[b] - z[a]));
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef COORDINATES_H
+#define COORDINATES_H
+
+#include <vector>
+
+using namespace std;
+
+#define EARTH_RADIUS 6371.0
+
+// Positions of a set of points (the airports of a graph, by node) as structure-of-arrays unit vectors, converted from
+// degrees once. The great-circle distance follows from the straight-line chord between two unit vectors, so the
+// batch kernels only need products, a square root and an arcsine, which they evaluate four at a time with AVX2 when
+// the CPU has it and one at a time otherwise (both give the same results). A single pair of stored points uses the
+// same series, so the route distances and the estimates of A* come from one formula; the haversine of two latitudes
+// and longitudes uses the arcsine of the C library, which differs from the series by less than 1e-11 km
+class Coordinates {
+public:
+    Coordinates() = default;
+    explicit Coordinates(int size);
+
+    void set(int i, double latitude, double longitude);
+    int getSize() const;
+
+    double distance(int a, int b) const;
+    void distances(double latitude, double longitude, const int* points, int n, double* res) const;
+    void distances(int src, const int* points, int n, double* res) const;
+    void distances(const int* src, const int* dest, int n, double* res) const;
+
+    static double distance(double lat1, double lon1, double lat2, double lon2);
+    static void unitVector(double latitude, double longitude, double& x, double& y, double& z);
+    static bool vectorized();    // true if the kernels use AVX2
+
+private:
+    vector<double> x, y, z;
+};
+
+#endif //COORDINATES_H
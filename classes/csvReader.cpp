@@ -0,0 +1,116 @@
+#include "csvReader.h"
+#include <charconv>
+#include <cstdlib>
+
+/**
+ * Maps a CSV file to read its records
+ * @param path - path of the file
+ */
+CsvReader::CsvReader(const string& path) : file(MappedFile::open(path)), cur(nullptr), end(nullptr) {
+    if (file) {
+        cur = file->data();
+        end = cur + file->size();
+    }
+}
+
+/**
+ * Reads the records of a buffer that the caller keeps alive (for instance one chunk of a mapped file)
+ * @param begin - first character of the buffer
+ * @param end - one past the last character of the buffer
+ */
+CsvReader::CsvReader(const char* begin, const char* end) : cur(begin), end(end) {}
+
+bool CsvReader::isOpen() const {return cur != nullptr;}
+size_t CsvReader::size() const {return fields.size();}
+string_view CsvReader::operator[](size_t i) const {return fields[i];}
+
+/**
+ * Reads a quoted field starting at the opening quote. Only fields with doubled quotes are copied, every other
+ * field is a view into the buffer\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>, n -> length of the field
+ * </pre>
+ * @return contents of the field, without the surrounding quotes
+ */
+string_view CsvReader::parseQuoted() {
+    const char* start = ++cur;
+    bool escaped = false;
+    while (cur < end) {
+        if (*cur == '"') {
+            if (cur + 1 < end && cur[1] == '"') {
+                escaped = true;
+                cur += 2;
+                continue;
+            }
+            break;
+        }
+        cur++;
+    }
+    string_view raw(start, cur - start);
+    if (cur < end) cur++;  // closing quote
+    while (cur < end && *cur != ',' && *cur != '\n') cur++;  // ignore anything between the closing quote and the separator
+
+    if (!escaped) return raw;
+    unescaped.emplace_back();
+    string& s = unescaped.back();
+    s.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+        s.push_back(raw[i]);
+        if (raw[i] == '"') i++;
+    }
+    return s;
+}
+
+/**
+ * Tokenizes the next record (line) of the buffer\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>, n -> length of the record
+ * </pre>
+ * @return true if a record was read, false at the end of the buffer
+ */
+bool CsvReader::next() {
+    fields.clear();
+    unescaped.clear();
+    if (cur == nullptr || cur >= end) return false;
+
+    while (true) {
+        if (cur < end && *cur == '"') fields.push_back(parseQuoted());
+        else {
+            const char* start = cur;
+            while (cur < end && *cur != ',' && *cur != '\n') cur++;
+            const char* last = cur;
+            if (last > start && last[-1] == '\r') last--;
+            fields.emplace_back(start, last - start);
+        }
+        if (cur < end && *cur == ',') {
+            cur++;
+            continue;
+        }
+        if (cur < end) cur++;  // line break
+        return true;
+    }
+}
+
+/**
+ * Parses a decimal number without allocating
+ * @param field - text of the field
+ * @param value - parsed number
+ * @return true if the whole field is a number
+ */
+bool CsvReader::toDouble(string_view field, double& value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto res = from_chars(field.data(), field.data() + field.size(), value);
+    return res.ec == errc() && res.ptr == field.data() + field.size();
+#else
+    char buffer[64];
+    if (field.empty() || field.size() >= sizeof(buffer)) return false;
+    field.copy(buffer, field.size());
+    buffer[field.size()] = '\0';
+    char* last;
+    value = strtod(buffer, &last);
+    return last == buffer + field.size();
+#endif
+}
+
@@ -0,0 +1,37 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <list>
+#include <memory>
+#include "mappedFile.h"
+
+using namespace std;
+
+// Streaming CSV tokenizer over a mapped file or any read buffer. Fields are views into the buffer and are only
+// valid until the next call to next(); quoted fields may contain commas, line breaks and doubled quotes ("")
+class CsvReader {
+public:
+    explicit CsvReader(const string& path);                // Read a whole file (mapped)
+    CsvReader(const char* begin, const char* end);        // Read the records of a buffer
+
+    bool isOpen() const;                  // Was the file found?
+    bool next();                          // Advance to the next record, false when there are no more
+    size_t size() const;                  // Number of fields of the current record
+    string_view operator[](size_t i) const;
+
+    static bool toDouble(string_view field, double& value);
+
+private:
+    string_view parseQuoted();
+
+    shared_ptr<MappedFile> file;
+    const char* cur;
+    const char* end;
+    vector<string_view> fields;
+    list<string> unescaped;               // storage for the quoted fields that contained doubled quotes
+};
+
+#endif //CSVREADER_H
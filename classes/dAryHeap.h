@@ -0,0 +1,161 @@
+#ifndef _DARYHEAP_H_
+#define _DARYHEAP_H_
+
+#include <vector>
+
+using namespace std;
+
+// Indexed d-ary min-heap of dense integer keys (0 .. n-1) with priorities of type V. The position of each key is
+// kept in a flat array, so hasKey and decreaseKey are O(1) lookups, and a wider node (D children) makes the tree
+// shallower and its siblings contiguous in memory
+template <class V, int D = 4>
+class DAryHeap {
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+    struct Node { // An element of the heap: a pair (value, key)
+        V value;
+        int key;
+    };
+
+    vector<Node> a;            // The heap array, root at a[0]
+    vector<int> pos;           // position of each key on the array a, -1 if it is not on the heap
+
+    void upHeap(int i);
+    void downHeap(int i);
+
+public:
+    explicit DAryHeap(int n = 0);  // Create an empty heap for the keys 0 .. n-1
+    void reserve(int n);           // Make room for the keys 0 .. n-1
+    int getSize() const;           // Return number of elements in the heap
+    bool empty() const;
+    bool hasKey(int key) const;    // Heap has key?
+    void insert(int key, const V& value);        // Insert (key, value) on the heap
+    void decreaseKey(int key, const V& value);   // Decrease value of key
+    void push(int key, const V& value);          // Insert key, or decrease its value if it is already on the heap
+    int top() const;               // key with smaller value (the heap must not be empty)
+    const V& topValue() const;     // its value
+    int removeMin();               // remove and return key with smaller value, -1 if empty
+    void clear();                  // remove every element, in O(size)
+};
+
+// ----------------------------------------------
+
+// Make a value go "up the tree" until it reaches its position
+template <class V, int D>
+void DAryHeap<V,D>::upHeap(int i) {
+    Node node = a[i];
+    while (i > 0) {
+        int parent = (i - 1) / D;
+        if (!(node.value < a[parent].value)) break;
+        a[i] = a[parent];
+        pos[a[i].key] = i;
+        i = parent;
+    }
+    a[i] = node;
+    pos[node.key] = i;
+}
+
+// Make a value go "down the tree" until it reaches its position
+template <class V, int D>
+void DAryHeap<V,D>::downHeap(int i) {
+    Node node = a[i];
+    int n = (int) a.size();
+    while (true) {
+        int first = i * D + 1;
+        if (first >= n) break;
+        int last = first + D < n ? first + D : n;
+        int j = first;
+        for (int c = first + 1; c < last; c++)   // choose smaller child
+            if (a[c].value < a[j].value) j = c;
+        if (!(a[j].value < node.value)) break;
+        a[i] = a[j];
+        pos[a[i].key] = i;
+        i = j;
+    }
+    a[i] = node;
+    pos[node.key] = i;
+}
+
+// ----------------------------------------------
+
+template <class V, int D>
+DAryHeap<V,D>::DAryHeap(int n) : pos(n, -1) {
+}
+
+template <class V, int D>
+void DAryHeap<V,D>::reserve(int n) {
+    if ((int) pos.size() < n) pos.resize(n, -1);
+}
+
+template <class V, int D>
+int DAryHeap<V,D>::getSize() const {
+    return (int) a.size();
+}
+
+template <class V, int D>
+bool DAryHeap<V,D>::empty() const {
+    return a.empty();
+}
+
+template <class V, int D>
+bool DAryHeap<V,D>::hasKey(int key) const {
+    return pos[key] != -1;
+}
+
+// Insert (key, value) on the heap
+template <class V, int D>
+void DAryHeap<V,D>::insert(int key, const V& value) {
+    if (hasKey(key)) return;     // key already exists, do nothing
+    a.push_back({value, key});
+    upHeap((int) a.size() - 1);
+}
+
+// Decrease value of key to the indicated value
+template <class V, int D>
+void DAryHeap<V,D>::decreaseKey(int key, const V& value) {
+    if (!hasKey(key)) return;  // key does not exist, do nothing
+    int i = pos[key];
+    if (a[i].value < value) return;  // value would increase, do nothing
+    a[i].value = value;
+    upHeap(i);
+}
+
+template <class V, int D>
+void DAryHeap<V,D>::push(int key, const V& value) {
+    if (hasKey(key)) decreaseKey(key, value);
+    else insert(key, value);
+}
+
+template <class V, int D>
+int DAryHeap<V,D>::top() const {
+    return a[0].key;
+}
+
+template <class V, int D>
+const V& DAryHeap<V,D>::topValue() const {
+    return a[0].value;
+}
+
+// remove and return key with smaller value
+template <class V, int D>
+int DAryHeap<V,D>::removeMin() {
+    if (a.empty()) return -1;
+    int min = a[0].key;
+    pos[min] = -1;
+    if (a.size() > 1) {
+        a[0] = a.back();
+        a.pop_back();
+        downHeap(0);
+    }
+    else a.pop_back();
+    return min;
+}
+
+// Only the keys still on the heap have a position to reset, so a heap can be reused by consecutive searches
+template <class V, int D>
+void DAryHeap<V,D>::clear() {
+    for (const auto& node : a) pos[node.key] = -1;
+    a.clear();
+}
+
+#endif
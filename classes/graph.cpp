@@ -1,28 +1,48 @@
 #include "graph.h"
-#include "supervisor.h"
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#define DISTANCE_EPSILON 1e-6   // km, distances closer than this are the same (rounding is below 1e-11 km a flight)
+#define SOURCES_PER_PASS 256    // sources searched together by eccentricities(), a multiple of 64
 
 /**
  * Graph class constructor
  * @param size - number of nodes
  */
-Graph::Graph(int size) : nodes(size+1){
+Graph::Graph(int size) : nodes(size+1), coordinates(size+1), offsets(size+2, 0){
     this->size = size;
 }
 
 /**
- * Adds an edge from source to destination with an airline and distance\n\n
+ * Adds a flight from source to destination with an airline and distance. Flights between the same pair of airports
+ * are merged into a single edge, and only become visible to the traversals after buildCSR() is called\n\n
  * <b>Complexity\n</b>
  * <pre>
  *      <b>O(1)</b>
  * </pre>
  * @param src - source node
  * @param dest - target node
- * @param airline - airline
+ * @param airline - id of the airline (see addAirline)
  * @param distance - distance between source airport and target airport
  */
-void Graph::addEdge(int src, int dest, Airline airline, double distance) {
-    if (src<1 || src>size || dest<1 || dest>size) return;
-    nodes[src].adj.push_back({dest,std::move(airline),distance});
+void Graph::addEdge(int src, int dest, int airline, double distance) {
+    if (src<1 || src>size || dest<1 || dest>size || airline<0) return;
+    pending.push_back({src, dest, airline, distance});
+}
+
+/**
+ * Adds a batch of flights. Like addEdge, they only become visible to the traversals after buildCSR() is called\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>, n -> number of flights in the batch
+ * </pre>
+ * @param flights - flights to add, in order
+ */
+void Graph::addEdges(const vector<Flight>& flights) {
+    pending.reserve(pending.size() + flights.size());
+    for (const auto& f : flights)
+        addEdge(f.src, f.dest, f.airline, f.distance);
 }
 
 /**
@@ -36,253 +56,597 @@ void Graph::addEdge(int src, int dest, Airline airline, double distance) {
  */
 void Graph::addAirport(int src, Airport airport) {
     if (src<1 || src>size) return;
-    nodes[src].airport = std::move(airport);
+    auto country = idCountries.emplace(airport.getCountry(), (int) countries.size());
+    if (country.second) countries.push_back(airport.getCountry());
+    auto city = idCities.emplace(make_pair(airport.getCountry(), airport.getCity()), (int) cities.size());
+    if (city.second) cities.push_back(city.first->first);
+    coordinates.set(src, airport.getLatitude(), airport.getLongitude());
+    nodes[src] = {std::move(airport), city.first->second, country.first->second};
 }
 
-vector<Graph::Node> Graph::getNodes() const{
-    return nodes;
+/**
+ * Interns an airline under a dense id, used by the edges and by the airline filters\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param id - dense airline id (0, 1, 2, ...)
+ * @param airline - airline
+ */
+void Graph::addAirline(int id, Airline airline) {
+    if (id < 0) return;
+    if (id >= (int) airlines.size()) airlines.resize(id+1, Airline(""));
+    idAirlines[airline.getCode()] = id;
+    airlines[id] = std::move(airline);
 }
 
 /**
- * Calculates the distance between two points on a sphere using their latitudes and longitudes measured along the surface\n\n
+ * Packs the added flights into the compressed sparse row layout (offsets array plus contiguous edge array)
+ * that every traversal iterates over. The flights of each pair of airports become one edge whose airlines are
+ * stored as a contiguous slice of the airline id array; edges keep the order in which their route first appeared,
+ * and airlines the order in which they were added. The incoming edges of every node are packed the same way, for
+ * the searches that run backwards from a target. Must be called once the graph has been loaded\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(log(n))</b>, n -> input
+ *      <b>O(|V| + |F| * a)</b>, V -> number of nodes, F -> number of flights, a -> airlines of a route
  * </pre>
- * @param lat1 - latitude of point 1
- * @param lon1 - longitude of point 1
- * @param lat2 - latitude of point 2
- * @param lon2 - longitude of point 2
- * @return distance between two points on a sphere
  */
-double Graph::distance(double lat1, double lon1, double lat2, double lon2) {
-    double dLat = (lat2 - lat1) * M_PI / 180.0;
-    double dLon = (lon2 - lon1) * M_PI / 180.0;
+void Graph::buildCSR() {
+    if (pending.empty()) return;
+
+    vector<Flight> all;
+    all.reserve(totalFlights() + pending.size());
+    for (int v = 1; v <= size; v++)
+        for (const Edge& e : adj(v))
+            for (int airline : airlinesOf(e))
+                all.push_back({v, e.dest, airline, e.distance});
+    all.insert(all.end(), pending.begin(), pending.end());
+
+    vector<int> start(size+2, 0);
+    for (const auto& f : all)
+        start[f.src+1]++;
+    for (int v = 1; v <= size; v++)
+        start[v+1] += start[v];
+
+    vector<Flight> sorted(all.size());
+    vector<int> next(start.begin(), start.end());
+    for (const auto& f : all)
+        sorted[next[f.src]++] = f;
+
+    vector<Edge> packed;
+    vector<int> packedAirlines;
+    packedAirlines.reserve(all.size());
+    vector<int> route(size+1, -1);         // route of the current node that reaches each destination
+    vector<int> routeOf(all.size());       // route of each flight, relative to the first route of its node
+    vector<int> byRoute(all.size());       // flights of the current node grouped by route, in order
+    vector<int> count;
+    vector<int> seen(airlines.size(), -1); // last edge that listed each airline
+    offsets.assign(size+2, 0);
+
+    for (int v = 1; v <= size; v++) {
+        int first = (int) packed.size();
+        count.clear();
+        for (int i = start[v]; i < start[v+1]; i++) {
+            const Flight& f = sorted[i];
+            if (route[f.dest] == -1) {
+                route[f.dest] = (int) count.size();
+                packed.push_back({f.dest, 0, 0, f.distance});
+                count.push_back(0);
+            }
+            routeOf[i] = route[f.dest];
+            count[routeOf[i]]++;
+        }
 
-    // convert to radians
-    lat1 = (lat1) * M_PI / 180.0;
-    lat2 = (lat2) * M_PI / 180.0;
+        int pos = start[v];
+        for (int& c : count) {
+            int n = c;
+            c = pos;
+            pos += n;
+        }
+        for (int i = start[v]; i < start[v+1]; i++)
+            byRoute[count[routeOf[i]]++] = i;
+
+        for (int i = start[v]; i < start[v+1]; i++) {
+            const Flight& f = sorted[byRoute[i]];
+            int id = first + routeOf[byRoute[i]];
+            Edge& e = packed[id];
+            if (e.nrAirlines == 0) e.firstAirline = (int) packedAirlines.size();
+            if (f.airline >= (int) seen.size()) seen.resize(f.airline+1, -1);
+            if (seen[f.airline] == id) continue;
+            seen[f.airline] = id;
+            packedAirlines.push_back(f.airline);
+            e.nrAirlines++;
+        }
+        for (int i = first; i < (int) packed.size(); i++)
+            route[packed[i].dest] = -1;
+        offsets[v+1] = (int) packed.size();
+    }
+
+    reverseOffsets.assign(size+2, 0);
+    for (const Edge& e : packed)
+        reverseOffsets[e.dest+1]++;
+    for (int v = 1; v <= size; v++)
+        reverseOffsets[v+1] += reverseOffsets[v];
+    reverseEdges.assign(packed.size(), Edge());
+    vector<int> slot(reverseOffsets.begin(), reverseOffsets.end());
+    for (int v = 1; v <= size; v++)
+        for (int i = offsets[v]; i < offsets[v+1]; i++) {
+            const Edge& e = packed[i];
+            reverseEdges[slot[e.dest]++] = {v, e.firstAirline, e.nrAirlines, e.distance};
+        }
 
-    // apply formulae
-    double a = pow(sin(dLat / 2), 2) + pow(sin(dLon / 2), 2) * cos(lat1) * cos(lat2);
-    double rad = 6371;
-    double c = 2 * asin(sqrt(a));
-    return rad * c;
+    edges = std::move(packed);
+    edgeAirlines = std::move(packedAirlines);
+    pending.clear();
+    pending.shrink_to_fit();
+    mapped = CSRView();
+    mapping.reset();
 }
 
 /**
- * Calculates the minimum number of flights between source airport and target airport using airlines \n \n
+ * Makes the graph traverse CSR arrays that live in memory it does not own (a mapped snapshot), without copying them\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
+ *      <b>O(1)</b>
  * </pre>
- * @param src - source node / node of source airport
- * @param dest - target node
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
- * @return minimum number of flights between source airport and target airport using airlines
+ * @param owner - object that keeps the arrays alive for as long as the graph uses them
+ * @param arrays - CSR arrays, with the layout produced by buildCSR()
  */
-int Graph::nrFlights(int src, int dest, Airline::AirlineH airlines){
-    for (int i = 1; i <= size; i++) {
-        nodes[i].visited = false;
-        nodes[i].distance = 0;
-    }
+void Graph::adoptCSR(shared_ptr<const void> owner, const CSRView& arrays) {
+    offsets.clear();
+    edges.clear();
+    edgeAirlines.clear();
+    reverseOffsets.clear();
+    reverseEdges.clear();
+    pending.clear();
+    mapping = std::move(owner);
+    mapped = arrays;
+}
 
-    queue<int> q;
-    q.push(src);
+/**
+ * @return the CSR arrays the traversals currently use (owned or mapped)
+ */
+Graph::CSRView Graph::csr() const {
+    return {csrOffsets(), csrEdges(), nrEdges(), csrEdgeAirlines(), totalFlights(), csrReverseOffsets(), csrReverseEdges()};
+}
 
-    nodes[src].visited = true;
+const int* Graph::csrOffsets() const {
+    return mapped.edges ? mapped.offsets : offsets.data();
+}
 
-    while(!q.empty()){
-        int u = q.front(); q.pop();
-        for (const Edge& e : nodes[u].adj){
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
-            int w = e.dest;
-            if (!nodes[w].visited){
-                q.push(w);
-                nodes[w].visited = true;
-                nodes[w].distance = nodes[u].distance + 1;
-            }
-        }
-    }
+const Graph::Edge* Graph::csrEdges() const {
+    return mapped.edges ? mapped.edges : edges.data();
+}
+
+const int* Graph::csrEdgeAirlines() const {
+    return mapped.edges ? mapped.edgeAirlines : edgeAirlines.data();
+}
+
+const int* Graph::csrReverseOffsets() const {
+    return mapped.edges ? mapped.reverseOffsets : reverseOffsets.data();
+}
+
+const Graph::Edge* Graph::csrReverseEdges() const {
+    return mapped.edges ? mapped.reverseEdges : reverseEdges.data();
+}
 
-    return nodes[dest].distance;
+const vector<Graph::Node>& Graph::getNodes() const{
+    return nodes;
 }
 
+const Coordinates& Graph::getCoordinates() const {return coordinates;}
+
 /**
- * Calculates the number of flights of a specific airline\n\n
+ * @param v - node
+ * @return airport stored in node v
+ */
+const Airport& Graph::getAirport(int v) const {
+    return nodes[v].airport;
+}
+
+/**
+ * Gives the outgoing edges of a node as a contiguous range of the CSR edge array\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|E|)</b>, E -> number of edges
+ *      <b>O(1)</b>
  * </pre>
- * @param airline
- * @return number of flights of a specific airline
+ * @param v - source node
+ * @return range over the edges that leave node v
  */
-int Graph::airlineFlights(const string& airline){
-    int count = 0;
-    for (int i = 1 ; i <= size; i++)
-        for (const Edge& e : nodes[i].adj)
-            if (e.airline.getCode() == airline)
-                count++;
-    return count;
-}
-
-bool cmp( const pair<int,string>& a, const pair<int,string>& b){
-    return a.first > b.first;
+Graph::EdgeRange Graph::adj(int v) const {
+    const int* off = csrOffsets();
+    const Edge* base = csrEdges();
+    return {base + off[v], base + off[v+1]};
 }
 
 /**
- * Calculates the number of departures of each airport.\n\n
+ * Gives the incoming edges of a node as a contiguous range of the reverse CSR edge array (the dest of each edge
+ * is the airport the route leaves from)\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V|*log(|V|))</b>, V -> number of nodes
+ *      <b>O(1)</b>
  * </pre>
- * @return ordered vector of pair<Number of departures,Airport Code> by descending order of number of flights
+ * @param v - target node
+ * @return range over the edges that arrive at node v
  */
-vector<pair<int, string>> Graph::flightsPerAirport() {
-    vector<pair<int,string>> n;
+Graph::EdgeRange Graph::radj(int v) const {
+    const int* off = csrReverseOffsets();
+    const Edge* base = csrReverseEdges();
+    return {base + off[v], base + off[v+1]};
+}
 
-    for (int i = 1; i <= size; i++){
-        int nrFlights = nodes[i].adj.size();
-        n.emplace_back(nrFlights, nodes[i].airport.getCode());
-    }
+/**
+ * @return range over every edge of the graph, grouped by source node
+ */
+Graph::EdgeRange Graph::allEdges() const {
+    return {csrEdges(), csrEdges() + nrEdges()};
+}
 
-    sort(n.begin(), n.end(), cmp);
-    return n;
+/**
+ * @return number of nodes (airports)
+ */
+int Graph::getSize() const {
+    return size;
 }
 
 /**
- * Calculates the number of airlines that work with each airport.\n\n
- * <b>Complexity\n</b>
- * <pre>
- *      <b>O(|V| + |E| + n * log(n))</b>, V -> number of nodes, E -> number of edges, n -> size of nrAirlines
- * </pre>
- * @return ordered vector of pair<Number of airlines,Airport Code> by descending order of number of airlines
+ * @return total number of edges (routes between two airports) in the graph
  */
-vector<pair<int,string>> Graph::airlinesPerAirport() {
+int Graph::nrEdges() const {
+    return mapped.edges ? mapped.nrEdges : (int) edges.size();
+}
 
-    vector<pair<int,string>> nrAirlines;
+/**
+ * @param e - edge of this graph
+ * @return range over the ids of the airlines that fly the route of the edge
+ */
+Graph::AirlineRange Graph::airlinesOf(const Edge& e) const {
+    const int* base = csrEdgeAirlines() + e.firstAirline;
+    return {base, base + e.nrAirlines};
+}
 
-    for (int i = 1; i <= size; i++){
-        set<string> n;
+/**
+ * @return total number of flights (route, airline) in the graph
+ */
+int Graph::totalFlights() const {
+    return mapped.edges ? mapped.nrFlights : (int) edgeAirlines.size();
+}
 
-        for (const Edge& e : nodes[i].adj)
-            n.insert(e.airline.getCode());
+/**
+ * Counts the flights that leave an airport, one per airline of each route\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|E|)</b>, E -> number of edges of node v
+ * </pre>
+ * @param v - source node
+ * @return number of departures of node v
+ */
+int Graph::departures(int v) const {
+    int count = 0;
+    for (const Edge& e : adj(v))
+        count += e.nrAirlines;
+    return count;
+}
 
-        nrAirlines.emplace_back(n.size(), nodes[i].airport.getCode());
-    }
+/**
+ * @return number of interned airlines
+ */
+int Graph::nrAirlines() const {
+    return (int) airlines.size();
+}
 
-    sort(nrAirlines.begin(), nrAirlines.end(), cmp);
+/**
+ * @param id - dense airline id
+ * @return airline interned under that id
+ */
+const Airline& Graph::getAirline(int id) const {
+    return airlines[id];
+}
 
-    return nrAirlines;
+/**
+ * @param code - airline code
+ * @return dense id of the airline, or -1 if there is no such airline
+ */
+int Graph::getAirlineId(const string& code) const {
+    auto it = idAirlines.find(code);
+    if (it == idAirlines.end()) return -1;
+    return it->second;
 }
 
 /**
- * Calculates the reachable airports using "max" number of flights\n\n
+ * Compiles a set of airlines into a bitset over the airline ids, so that the searches test each edge with a single bit lookup\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
+ *      <b>O(n + m)</b>, n -> size of airlines, m -> number of interned airlines
  * </pre>
- * @param v - source node
- * @param max - number of flights
- * @return set of reachable airports using "max" number of flights
+ * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+ * @return filter accepting exactly the given airlines (or all of them if the set is empty)
+ */
+AirlineMask Graph::compileFilter(const Airline::AirlineH& airlines) const {
+    if (airlines.empty()) return {};
+    AirlineMask mask((int) this->airlines.size());
+    for (const auto& airline : airlines)
+        mask.set(getAirlineId(airline.getCode()));
+    return mask;
+}
+
+/**
+ * @return number of interned cities
+ */
+int Graph::nrCities() const {
+    return (int) cities.size();
+}
+
+/**
+ * @return number of interned countries
  */
-Airport::AirportH Graph::listAirports(int v, int max) {
+int Graph::nrCountries() const {
+    return (int) countries.size();
+}
 
-    for (int i = 1; i <= size; i++)
-        nodes[i].visited = false;
+/**
+ * @param id - interned city id (see Reach)
+ * @return (country, city) of the id
+ */
+const pair<string, string>& Graph::getCity(int id) const {
+    return cities[id];
+}
 
-    Airport::AirportH airports;
+/**
+ * @param id - interned country id (see Reach)
+ * @return name of the country
+ */
+const string& Graph::getCountry(int id) const {
+    return countries[id];
+}
 
-    queue<int> q;
-    q.push(v);
-    nodes[v].visited = true;
-    nodes[v].distance = 0;
+/**
+ * Calculates the distance between two points on a sphere using their latitudes and longitudes measured along the surface
+ * (see Coordinates::distance)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param lat1 - latitude of point 1
+ * @param lon1 - longitude of point 1
+ * @param lat2 - latitude of point 2
+ * @param lon2 - longitude of point 2
+ * @return distance between two points on a sphere
+ */
+double Graph::distance(double lat1, double lon1, double lat2, double lon2) {
+    return Coordinates::distance(lat1, lon1, lat2, lon2);
+}
 
-    while (!q.empty()) {
-        int u = q.front(); q.pop();
-        for (const auto& e : nodes[u].adj) {
-            int w = e.dest;
-            if (!nodes[w].visited) {
-                q.push(w);
-                nodes[w].visited = true;
-                nodes[w].distance = nodes[u].distance +1;
-                if (nodes[w].distance<=max) airports.insert(nodes[w].airport);
+/**
+ * Calculates the minimum number of flights between source airport and target airport using airlines.
+ * Runs a breadth-first search from each end at the same time (forwards over adj, backwards over radj), always
+ * expanding a whole layer of the smaller frontier, and stops at the first layer where both searches meet.
+ * Only the nodes reached by the two searches are touched\n \n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges (in the worst case)
+ * </pre>
+ * @param src - source node / node of source airport
+ * @param dest - target node
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @return minimum number of flights between source airport and target airport using airlines (0 if unreachable)
+ */
+int Graph::nrFlights(int src, int dest, const AirlineMask& airlines, SearchWorkspace& ws) const{
+    if (src == dest) return 0;
+    ws.bounded.resize(size+1);
+    SearchWorkspace::Bounded& state = ws.bounded;
+
+    state.forward[src] = 0;
+    state.backward[dest] = 0;
+    state.touched.assign({src, dest});
+    state.forwardFrontier.assign(1, src);
+    state.backwardFrontier.assign(1, dest);
+    int best = INT_MAX;
+
+    while (best == INT_MAX && !state.forwardFrontier.empty() && !state.backwardFrontier.empty()) {
+        bool forwards = state.forwardFrontier.size() <= state.backwardFrontier.size();
+        vector<int>& frontier = forwards ? state.forwardFrontier : state.backwardFrontier;
+        vector<int>& hops = forwards ? state.forward : state.backward;
+        const vector<int>& other = forwards ? state.backward : state.forward;
+
+        state.nextFrontier.clear();
+        for (int u : frontier) {
+            for (const Edge& e : forwards ? adj(u) : radj(u)) {
+                if (!airlines.acceptsAny(airlinesOf(e))) continue;
+                int w = e.dest;
+                if (other[w] != -1) best = min(best, hops[u] + 1 + other[w]);
+                if (hops[w] == -1) {
+                    hops[w] = hops[u] + 1;
+                    state.touched.push_back(w);
+                    state.nextFrontier.push_back(w);
+                }
             }
         }
+        frontier.swap(state.nextFrontier);
     }
-    return airports;
+
+    for (int v : state.touched)
+        state.forward[v] = state.backward[v] = -1;
+    return best == INT_MAX ? 0 : best;
 }
 
 /**
- * Calculates the reachable cities using "max" number of flights\n\n
+ * Calculates the minimum number of flights from any of the source airports to any of the target airports (never
+ * from an airport to itself) and which pairs achieve it, with a single breadth-first search. Every source owns one
+ * bit of a bitset per node, so the search follows all of them at once, one layer at a time, and stops at the first
+ * layer that reaches a target from another airport. A single pair is answered by the bidirectional search\n \n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
+ *      <b>O((|V| + |E|) * s/64 + s*t)</b>, V -> number of nodes, E -> number of edges, s -> sources, t -> targets
  * </pre>
- * @param v - source node
- * @param max - number of flights
- * @return unordered_set of reachable cities using "max" number of flights
+ * @param src - source nodes
+ * @param dest - target nodes
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @param pairs - receives the pairs (source, target) at the minimum number of flights, sources first
+ * @return minimum number of flights, 0 if no target can be reached
  */
-Airport::CityH2 Graph::listCities(int v, int max) {
-    for (int i = 1; i <= size; i++)
-        nodes[i].visited = false;
+int Graph::nrFlights(const vector<int>& src, const vector<int>& dest, const AirlineMask& airlines, SearchWorkspace& ws,
+                     vector<pair<int, int>>& pairs) const {
+    pairs.clear();
+    if (src.size() == 1 && dest.size() == 1) {
+        int flights = src[0] == dest[0] ? 0 : nrFlights(src[0], dest[0], airlines, ws);
+        if (flights != 0) pairs.emplace_back(src[0], dest[0]);
+        return flights;
+    }
+    if (src.empty() || dest.empty()) return 0;
+
+    ws.multiSource.resize(size+1);
+    SearchWorkspace::MultiSource& state = ws.multiSource;
+    size_t words = (src.size() + 63) / 64;
+    state.origins.assign((size+1) * words, 0);
+    state.fresh.assign((size+1) * words, 0);
+    state.incoming.assign((size+1) * words, 0);
+    for (int v = 1; v <= size; v++)
+        state.target[v] = false;
+    for (int d : dest)
+        state.target[d] = true;
+
+    vector<int>& frontier = state.frontier;
+    frontier.clear();
+    for (size_t i = 0; i < src.size(); i++) {
+        size_t at = src[i] * words;
+        if (all_of(state.fresh.begin() + at, state.fresh.begin() + at + words, [](uint64_t w) {return w == 0;}))
+            frontier.push_back(src[i]);
+        state.origins[at + i / 64] |= (uint64_t) 1 << (i & 63);
+        state.fresh[at + i / 64] |= (uint64_t) 1 << (i & 63);
+    }
 
-    Airport::CityH2 cities;
+    for (int layer = 1; !frontier.empty(); layer++) {
+        state.nextFrontier.clear();
+        for (int u : frontier)
+            for (const Edge& e : adj(u)) {
+                if (!airlines.acceptsAny(airlinesOf(e))) continue;
+                size_t from = u * words, to = e.dest * words;
+                bool first = true, arrived = false;
+                for (size_t k = 0; k < words; k++) {
+                    first = first && state.incoming[to+k] == 0;
+                    uint64_t bits = state.fresh[from+k] & ~state.origins[to+k];
+                    state.incoming[to+k] |= bits;
+                    arrived = arrived || bits != 0;
+                }
+                if (first && arrived) state.nextFrontier.push_back(e.dest);
+            }
 
-    queue<int> q;
-    q.push(v);
-    nodes[v].visited = true;
-    nodes[v].distance = 0;
+        for (int u : frontier)
+            fill(state.fresh.begin() + u * words, state.fresh.begin() + (u+1) * words, 0);
+        bool found = false;
+        for (int w : state.nextFrontier) {
+            for (size_t k = 0; k < words; k++) {
+                state.fresh[w * words + k] = state.incoming[w * words + k];
+                state.origins[w * words + k] |= state.incoming[w * words + k];
+                state.incoming[w * words + k] = 0;
+            }
+            found = found || state.target[w];
+        }
 
-    while (!q.empty()) {
-        int u = q.front(); q.pop();
-        for (const auto& e : nodes[u].adj) {
-            int w = e.dest;
-            if (!nodes[w].visited) {
-                q.push(w);
-                nodes[w].visited = true;
-                nodes[w].distance = nodes[u].distance +1;
-                if (nodes[w].distance <= max) cities.insert({nodes[w].airport.getCountry(),nodes[w].airport.getCity()});
+        if (found) {
+            for (size_t i = 0; i < src.size(); i++)
+                for (int d : dest)
+                    if (d != src[i] && (state.fresh[d * words + i / 64] >> (i & 63)) & 1)
+                        pairs.emplace_back(src[i], d);
+            if (!pairs.empty()) {
+                for (int d : dest) state.target[d] = false;
+                return layer;
             }
         }
+        frontier.swap(state.nextFrontier);
     }
-    return cities;
+    for (int d : dest) state.target[d] = false;
+    return 0;
 }
 
 /**
- * Calculates the reachable countries using "max" number of flights\n\n
+ * Calculates the number of flights of a specific airline\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
+ *      <b>O(|E|)</b>, E -> number of edges
  * </pre>
- * @param v - source node
- * @param max - number of flights
- * @return set of reachable countries using "max" number of flights
+ * @param airline
+ * @return number of flights of a specific airline
  */
-set<string> Graph::listCountries(int v, int max) {
-    for (int i = 1; i <= size; i++)
-        nodes[i].visited = false;
-
-    set<string> countries;
-
-    queue<int> q;
-    q.push(v);
-    nodes[v].visited = true;
-    nodes[v].distance = 0;
+int Graph::airlineFlights(const string& airline) const{
+    int id = getAirlineId(airline);
+    int count = 0;
+    for (const Edge& e : allEdges())
+        for (int a : airlinesOf(e))
+            if (a == id)
+                count++;
+    return count;
+}
 
-    while (!q.empty()) {
-        int u = q.front(); q.pop();
-        for (const auto& e : nodes[u].adj) {
+/**
+ * Calculates the airports, cities and countries that can be reached using at most "max" flights, with one
+ * breadth-first search that stops at layer max\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V'| + |E'|)</b>, V' -> nodes at most max flights away, E' -> their edges
+ * </pre>
+ * @param src - source node
+ * @param max - number of flights
+ * @param ws - search workspace that holds the traversal state
+ * @return what was reached (src itself is not, though its city and country are if another airport there is)
+ */
+Graph::Reach Graph::reach(int src, int max, SearchWorkspace& ws) const {
+    ws.bounded.resize(size+1);
+    SearchWorkspace::Bounded& state = ws.bounded;
+    vector<pair<int, int>> reached;
+
+    vector<int>& q = state.forwardFrontier;
+    q.assign(1, src);
+    state.forward[src] = 0;
+    for (size_t head = 0; head < q.size(); head++) {
+        int u = q[head];
+        int layer = state.forward[u] + 1;
+        if (layer > max) break;
+        for (const auto& e : adj(u)) {
             int w = e.dest;
-            if (!nodes[w].visited) {
-                q.push(w);
-                nodes[w].visited = true;
-                nodes[w].distance = nodes[u].distance +1;
-                if (nodes[w].distance <= max) countries.insert(nodes[w].airport.getCountry());
-            }
+            if (state.forward[w] != -1) continue;
+            state.forward[w] = layer;
+            q.push_back(w);
+            reached.emplace_back(w, layer);
+        }
+    }
+    for (int v : q) state.forward[v] = -1;
+    return tally(reached);
+}
+
+/**
+ * Groups reached airports into cities and countries, by their interned ids, and counts what each number of flights
+ * reached first\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n + c)</b>, n -> reached airports, c -> number of interned cities and countries
+ * </pre>
+ * @param reached - (node, flights) of the reached airports, nearest first
+ * @return what was reached
+ */
+Graph::Reach Graph::tally(const vector<pair<int, int>>& reached) const {
+    Reach res;
+    vector<bool> cityReached(cities.size(), false), countryReached(countries.size(), false);
+    for (const auto& [w, layer] : reached) {
+        while ((int) res.layers.size() < layer) res.layers.emplace_back();
+        Reach::Layer& counts = res.layers[layer-1];
+        res.airports.push_back(w);
+        counts.airports++;
+        if (!cityReached[nodes[w].city]) {
+            cityReached[nodes[w].city] = true;
+            res.cities.push_back(nodes[w].city);
+            counts.cities++;
+        }
+        if (!countryReached[nodes[w].country]) {
+            countryReached[nodes[w].country] = true;
+            res.countries.push_back(nodes[w].country);
+            counts.countries++;
         }
     }
-    return countries;
+    return res;
 }
 
 /**
@@ -294,9 +658,9 @@ set<string> Graph::listCountries(int v, int max) {
  * @param source - source node
  * @return unordered_set of airports code and name
  */
-Graph::PairH Graph::airportsFromAirport(int source) {
+Graph::PairH Graph::airportsFromAirport(int source) const {
     Graph::PairH ans;
-    for(const auto& e:nodes[source].adj)
+    for(const auto& e:adj(source))
         ans.insert({nodes[e.dest].airport.getCode(),nodes[e.dest].airport.getName()});
     return ans;
 }
@@ -310,10 +674,11 @@ Graph::PairH Graph::airportsFromAirport(int source) {
  * @param i - source node
  * @return set of all the different airlines
  */
-unordered_set<string> Graph::airlinesFromAirport(int i) {
+unordered_set<string> Graph::airlinesFromAirport(int i) const {
     unordered_set<string> ans;
-    for (const Edge& e : nodes[i].adj)
-        ans.insert(e.airline.getCode());
+    for (const Edge& e : adj(i))
+        for (int a : airlinesOf(e))
+            ans.insert(airlines[a].getCode());
     return ans;
 }
 
@@ -326,9 +691,9 @@ unordered_set<string> Graph::airlinesFromAirport(int i) {
  * @param i - source node
  * @return set of all the different cities
  */
-Airport::CityH2 Graph::targetsFromAirport(int i){
+Airport::CityH2 Graph::targetsFromAirport(int i) const{
     Airport::CityH2 ans;
-    for (const auto& e:nodes[i].adj){
+    for (const auto& e:adj(i)){
         int w = e.dest;
         ans.insert({nodes[w].airport.getCountry(),nodes[w].airport.getCity()});
     }
@@ -344,9 +709,9 @@ Airport::CityH2 Graph::targetsFromAirport(int i){
  * @param i - source node
  * @return set of all the different countries
  */
-unordered_set<string> Graph::countriesFromAirport(int i) {
+unordered_set<string> Graph::countriesFromAirport(int i) const {
     unordered_set<string> ans;
-    for (const Edge& e : nodes[i].adj){
+    for (const Edge& e : adj(i)){
         int w = e.dest;
         ans.insert(nodes[w].airport.getCountry());
     }
@@ -361,315 +726,747 @@ unordered_set<string> Graph::countriesFromAirport(int i) {
  *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
  * </pre>
  * @param src - source node
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
  */
-void Graph::bfsPath(int src, Airline::AirlineH airlines){
+void Graph::bfsPath(int src, const AirlineMask& airlines, SearchWorkspace& ws) const{
+    ws.resize(size+1);
 
     for (int i = 1; i <= size; i++) {
-        nodes[i].distance = INT_MAX;
-        nodes[i].parents.clear();
+        ws.distance[i] = INT_MAX;
+        ws.parents[i].clear();
     }
     queue<int> q;
 
     q.push(src);
-    nodes[src].parents = {-1};
-    nodes[src].distance = 0;
+    ws.parents[src] = {-1};
+    ws.distance[src] = 0;
 
     while (!q.empty()) {
         int u = q.front();
         q.pop();
-        for (const auto& e : nodes[u].adj) {
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
+        for (const auto& e : adj(u)) {
+            if (!airlines.acceptsAny(airlinesOf(e))) continue;
             int v = e.dest;
-            if (nodes[v].distance > nodes[u].distance + 1) {
-                nodes[v].distance = nodes[u].distance + 1;
+            if (ws.distance[v] > ws.distance[u] + 1) {
+                ws.distance[v] = ws.distance[u] + 1;
                 q.push(v);
-                nodes[v].parents.clear();
-                nodes[v].parents.push_back(u);
+                ws.parents[v].clear();
+                ws.parents[v].push_back(u);
             }
-            else if (nodes[v].distance == nodes[u].distance + 1)
-                nodes[v].parents.push_back(u);
+            else if (ws.distance[v] == ws.distance[u] + 1)
+                ws.parents[v].push_back(u);
         }
     }
 }
 
 /**
- * Stores in paths all possible paths to node v.\n\n
+ * Calculates the minimum flown distance between source airport and target airport using airlines with A*.
+ * Nodes are expanded by flown distance plus the great-circle distance left to the target, which never overestimates
+ * the remaining flights (every edge is itself a great-circle distance, from the same Coordinates kernel, so the
+ * estimate is only off by rounding, far below DISTANCE_EPSILON), so only the nodes around the best route are
+ * expanded. Only the predecessors of each node are stored, every one of them that reaches it within DISTANCE_EPSILON
+ * of its minimum distance (like bfsPath does for flights), so that every route of that distance can be rebuilt
+ * afterwards; the search goes on past the target until no node left can be on a route tied with the best one\n \n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(n)</b> n -> paths size
+ *      <b>O(|E|*log(|V|))</b>, V -> number of nodes, E -> number of edges (in the worst case)
  * </pre>
- * @param paths - vector of paths that are possible
- * @param path - current path
- * @param v - target node
+ * @param src - source node / node of source airport
+ * @param dest - target node
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @return minimum flown distance between source airport and target airport using airlines, INF if unreachable
+ * (the predecessors on every best route are left in ws.parents, -1 for the source)
  */
-void Graph::findPaths(vector<vector<int>>& paths,vector<int>& path, int v){
-
-    if (v == -1) {
-        if (find(paths.begin(),paths.end(),path) == paths.end())
-            paths.push_back(path);
-        return;
+double Graph::aStar(int src, int dest, const AirlineMask& airlines, SearchWorkspace& ws) const {
+    ws.resize(size+1);
+    for (int v = 1; v <= size; v++) {
+        ws.distance[v] = INF;
+        ws.visited[v] = false;
+        ws.parents[v].clear();
     }
 
-    for (auto par : nodes[v].parents) {
-        path.push_back(v);
-        findPaths(paths,path, par);
-        path.pop_back();
+    DAryHeap<double>& q = ws.queue;
+    q.clear();
+    ws.distance[src] = 0;
+    ws.parents[src] = {-1};
+    q.insert(src, coordinates.distance(src, dest));
+
+    vector<int>& improved = ws.batch;
+    vector<double>& estimate = ws.batchDistance;
+    while (q.getSize() > 0 && q.topValue() <= ws.distance[dest] + DISTANCE_EPSILON) {
+        int u = q.removeMin();
+        ws.visited[u] = true;
+        if (u == dest) continue;
+
+        improved.clear();
+        for (const auto& e : adj(u)) {
+            if (!airlines.acceptsAny(airlinesOf(e))) continue;
+            int v = e.dest;
+            double d = ws.distance[u] + e.distance;
+            if (v == src || d > ws.distance[v] + DISTANCE_EPSILON) continue;
+
+            if (d < ws.distance[v] - DISTANCE_EPSILON) {
+                if (ws.visited[v]) continue;
+                ws.distance[v] = d;
+                ws.parents[v].assign(1, u);
+                improved.push_back(v);
+            }
+            // a tie may reach a node that is already settled, when both lie on the great circle to the target
+            else if (ws.distance[u] < ws.distance[v])
+                ws.parents[v].push_back(u);
+        }
+        // the estimates of every improved neighbour come from one call to the batch kernel
+        estimate.resize(improved.size());
+        coordinates.distances(dest, improved.data(), (int) improved.size(), estimate.data());
+        for (size_t i = 0; i < improved.size(); i++)
+            q.push(improved[i], ws.distance[improved[i]] + estimate[i]);
     }
+    return ws.distance[dest];
 }
 
 /**
- * Calculates the minimum flown distance between source airport and target airport using airlines \n \n
+ * Calculates the minimum flown distance from any of the source airports to any of the target airports (never from
+ * an airport to itself) and which pairs achieve it, with one Dijkstra seeded with every source at distance 0.
+ * Each node keeps the bitset of the sources at its distance (one bit per position of src, ties within
+ * DISTANCE_EPSILON as in aStar); while all of them are the same airport, it also keeps a second label with the
+ * nearest sources of the other airports, so that an airport that is both a source and a target is answered by the
+ * same search. A single pair is answered by A*\n \n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(log(|V|))</b>, V -> number of nodes
+ *      <b>O(|E|*log(|V|) * s/64 + s*t)</b>, V -> number of nodes, E -> number of edges, s -> sources, t -> targets
  * </pre>
- * @param src - source node / node of source airport
- * @param dest - target node
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
- * @return minimum flown distance between source airport and target airport using airlines
+ * @param src - source nodes
+ * @param dest - target nodes
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @param pairs - receives the pairs (source, target) at the minimum distance, sources first
+ * @return minimum flown distance, INF if no target can be reached
  */
-Graph::Node Graph::dijkstra(int src, int dest, Airline::AirlineH airlines) {
-
-    MinHeap<int, int> q(size, -1);
-
-    for (int v=1; v<=size; v++) {
-        nodes[v].distance = INF;
-        q.insert(v, INF);
-        nodes[v].visited = false;
-        nodes[v].parents.clear();
+double Graph::minDistance(const vector<int>& src, const vector<int>& dest, const AirlineMask& airlines, SearchWorkspace& ws,
+                          vector<pair<int, int>>& pairs) const {
+    pairs.clear();
+    if (src.size() == 1 && dest.size() == 1) {
+        if (src[0] == dest[0]) return INF;
+        double distance = aStar(src[0], dest[0], airlines, ws);
+        if (distance < INF) pairs.emplace_back(src[0], dest[0]);
+        return distance;
     }
-
-    nodes[src].distance = 0;
-    nodes[src].parents.push_back(src);
-    q.decreaseKey(src, 0);
-
-    while (q.getSize()>0) {
-        int u = q.removeMin();
-        nodes[u].visited = true;
-
-        for (const auto& e : nodes[u].adj) {
-
-            if (!airlines.empty() && airlines.find(e.airline) == airlines.end()) continue;
-
-            int v = e.dest;
-            double w = e.distance;
-
-            if (!nodes[v].visited && nodes[u].distance + w < nodes[v].distance) {
-                nodes[v].distance = nodes[u].distance + w;
-                auto aux =nodes[u].parents;
-                if (find(aux.begin(),aux.end(),v) == aux.end()) aux.push_back(v);
-                nodes[v].parents = aux;
-                q.decreaseKey(v, nodes[v].distance);
+    if (src.empty() || dest.empty()) return INF;
+
+    ws.resize(size+1);
+    ws.multiSource.resize(size+1);
+    SearchWorkspace::MultiSource& state = ws.multiSource;
+    size_t words = (src.size() + 63) / 64;
+    vector<bool> isSource(size+1, false);
+    for (int s : src) isSource[s] = true;
+    for (int d : dest) state.target[d] = true;
+
+    for (int v = 0; v <= size; v++) {
+        ws.distance[v] = INF;
+        ws.visited[v] = false;
+    }
+    state.origins.assign((size+1) * words, 0);
+    state.nearest.assign(size+1, -1);
+    state.secondDistance.assign(size+1, INF);
+    state.second.assign((size+1) * words, 0);
+    state.secondSettled.assign(size+1, false);
+    state.found.assign((size+1) * words, 0);
+
+    // the airport of every source in bits, -1 if they are not all the same one
+    auto airportOf = [&](const uint64_t* bits) {
+        int airport = -1;
+        for (size_t k = 0; k < words; k++)
+            for (uint64_t w = bits[k]; w != 0; w &= w - 1) {
+                int s = src[k * 64 + __builtin_ctzll(w)];
+                if (airport != -1 && s != airport) return -1;
+                airport = s;
+            }
+        return airport;
+    };
+    // copies the sources in bits that are not the airport x into out
+    auto without = [&](const uint64_t* bits, int x, uint64_t* out) {
+        copy(bits, bits + words, out);
+        for (size_t k = 0; k < words; k++)
+            for (uint64_t w = bits[k]; w != 0; w &= w - 1)
+                if (src[k * 64 + __builtin_ctzll(w)] == x) out[k] &= ~(w & -w);
+        return any_of(out, out + words, [](uint64_t w) {return w != 0;});
+    };
+    // merges a route of distance d from the sources in bits into the second label of v, true if it got shorter
+    auto offerSecond = [&](int v, double d, const uint64_t* bits) {
+        uint64_t* to = &state.second[v * words];
+        if (d > state.secondDistance[v] + DISTANCE_EPSILON) return false;
+        if (d < state.secondDistance[v] - DISTANCE_EPSILON) {
+            state.secondDistance[v] = d;
+            copy(bits, bits + words, to);
+            return true;
+        }
+        for (size_t k = 0; k < words; k++) to[k] |= bits[k];
+        return false;
+    };
+
+    DAryHeap<double>& q = ws.queue;     // key v is the first label of node v, v + size + 1 its second label
+    q.reserve(2 * (size+1));
+    q.clear();
+    vector<uint64_t> previous(words), other(words);
+    auto relax = [&](int v, double d, const uint64_t* bits) {
+        uint64_t* first = &state.origins[v * words];
+        if (d < ws.distance[v] - DISTANCE_EPSILON) {
+            if (ws.visited[v]) return;
+            int airport = airportOf(bits);
+            // the second label only matters while the first one holds a single airport
+            if (airport == -1 || airport != state.nearest[v]) {
+                copy(first, first + words, previous.begin());
+                state.secondDistance[v] = INF;
+                fill(state.second.begin() + v * words, state.second.begin() + (v+1) * words, 0);
+                if (airport != -1 && ws.distance[v] < INF && without(previous.data(), airport, other.data())
+                    && offerSecond(v, ws.distance[v], other.data()) && !state.secondSettled[v])
+                    q.push(v + size + 1, state.secondDistance[v]);
             }
+            ws.distance[v] = d;
+            state.nearest[v] = airport;
+            copy(bits, bits + words, first);
+            q.push(v, d);
         }
+        else if (d <= ws.distance[v] + DISTANCE_EPSILON) {
+            if (ws.visited[v]) return;
+            for (size_t k = 0; k < words; k++) first[k] |= bits[k];
+            if (state.nearest[v] != -1 && airportOf(first) == -1) state.nearest[v] = -1;
+        }
+        else if (state.nearest[v] != -1 && !state.secondSettled[v] && without(bits, state.nearest[v], other.data())
+                 && offerSecond(v, d, other.data()))
+            q.push(v + size + 1, d);
+    };
+
+    for (size_t i = 0; i < src.size(); i++) {
+        ws.distance[src[i]] = 0;
+        state.nearest[src[i]] = src[i];
+        state.origins[src[i] * words + i / 64] |= (uint64_t) 1 << (i & 63);
+        q.insert(src[i], 0);
     }
-    return nodes[dest];
+
+    double best = INF;
+    vector<pair<int, double>> reached;     // targets and their distance
+    while (q.getSize() > 0 && q.topValue() <= best + DISTANCE_EPSILON) {
+        int key = q.removeMin();
+        bool second = key > size;
+        int u = second ? key - size - 1 : key;
+        double distance = second ? state.secondDistance[u] : ws.distance[u];
+        const uint64_t* bits = second ? &state.second[u * words] : &state.origins[u * words];
+        if (second) {
+            if (state.nearest[u] == -1 || distance >= INF) continue;
+            state.secondSettled[u] = true;
+        }
+        else ws.visited[u] = true;
+
+        // a target is not expanded, except for the first label of a source; an airport that is both is not a target
+        // of itself, so it is answered by its other sources, or by its second label if there are none
+        if (state.target[u] && (isSource[u] ? second || without(bits, u, other.data()) : !second)) {
+            const uint64_t* found = isSource[u] && !second ? other.data() : bits;
+            copy(found, found + words, state.found.begin() + u * words);
+            reached.emplace_back(u, distance);
+            best = min(best, distance);
+        }
+        if (state.target[u] && (second || !isSource[u])) continue;
+
+        for (const auto& e : adj(u))
+            if (airlines.acceptsAny(airlinesOf(e)))
+                relax(e.dest, distance + e.distance, bits);
+    }
+    for (int d : dest) state.target[d] = false;
+    if (best >= INF) return INF;
+
+    for (const auto& r : reached)
+        if (r.second > best + DISTANCE_EPSILON)
+            fill(state.found.begin() + r.first * words, state.found.begin() + (r.first+1) * words, 0);
+    for (size_t i = 0; i < src.size(); i++)
+        for (int d : dest)
+            if ((state.found[d * words + i / 64] >> (i & 63)) & 1)
+                pairs.emplace_back(src[i], d);
+    return best;
 }
 
 /**
- * Calculates the max distance between connected nodes\n\n
+ * Fills one row of a route matrix: a breadth-first search (flights) or a Dijkstra (distance) from the source that
+ * stops as soon as every destination is settled\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
+ *      <b>O(|V|+|E|)</b> for flights, <b>O(|E|*log(|V|))</b> for distance, V -> number of nodes, E -> number of edges
  * </pre>
- * @param v - source node
- * @return the diameter of a connected component
+ * @param criterion - what the cells measure
+ * @param src - source node
+ * @param dest - destination node of each column
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @param row - receives one cell per destination, INF if unreachable
  */
-double Graph::bfsDiameter(int v) {
-    for (int i = 1; i <= size; i++){
-        nodes[i].visited = false;
-        nodes[i].distance = -1.0;
-    }
+void Graph::matrixRow(RouteMatrix::Criterion criterion, int src, const vector<int>& dest, const AirlineMask& airlines,
+                      SearchWorkspace& ws, double* row) const {
+    ws.resize(size+1);
+    ws.bounded.resize(size+1);
+    SearchWorkspace::Bounded& state = ws.bounded;
+    int remaining = 0;
+    for (int d : dest)
+        if (!state.target[d]) {
+            state.target[d] = true;
+            remaining++;
+        }
 
-    queue<int> q;
-    q.push(v);
-    nodes[v].visited = true;
-    nodes[v].distance = 0.0;
-    double max = 0;
-
-    while(!q.empty()){
-        int u = q.front(); q.pop();
-        for (const auto& e: nodes[u].adj){
-            int w = e.dest;
-            if (!nodes[w].visited){
-                q.push(w);
-                nodes[w].visited = true;
-                nodes[w].distance = nodes[u].distance + 1;
-                if (nodes[w].distance > max) max = nodes[w].distance;
+    state.touched.clear();
+    state.touched.push_back(src);
+    if (criterion == RouteMatrix::FLIGHTS) {
+        state.forward[src] = 0;
+        state.forwardFrontier.assign(1, src);
+        for (size_t head = 0; head < state.forwardFrontier.size() && remaining > 0; head++) {
+            int u = state.forwardFrontier[head];
+            if (state.target[u]) remaining--;
+            for (const auto& e : adj(u)) {
+                if (state.forward[e.dest] != -1 || !airlines.acceptsAny(airlinesOf(e))) continue;
+                state.forward[e.dest] = state.forward[u] + 1;
+                state.touched.push_back(e.dest);
+                state.forwardFrontier.push_back(e.dest);
+            }
+        }
+        for (size_t j = 0; j < dest.size(); j++)
+            row[j] = state.forward[dest[j]] == -1 ? INF : state.forward[dest[j]];
+        for (int v : state.touched) state.forward[v] = -1;
+    }
+    else {
+        DAryHeap<double>& q = ws.queue;
+        q.clear();
+        state.distance[src] = 0;
+        q.insert(src, 0);
+        while (q.getSize() > 0 && remaining > 0) {
+            int u = q.removeMin();
+            state.settled[u] = true;
+            if (state.target[u]) remaining--;
+            for (const auto& e : adj(u)) {
+                int v = e.dest;
+                double d = state.distance[u] + e.distance;
+                if (state.settled[v] || d >= state.distance[v] || !airlines.acceptsAny(airlinesOf(e))) continue;
+                if (state.distance[v] >= INF) state.touched.push_back(v);
+                state.distance[v] = d;
+                q.push(v, d);
             }
         }
+        for (size_t j = 0; j < dest.size(); j++)
+            row[j] = state.settled[dest[j]] ? state.distance[dest[j]] : INF;
+        for (int v : state.touched) {
+            state.distance[v] = INF;
+            state.settled[v] = false;
+        }
     }
-    return max;
+    for (int d : dest) state.target[d] = false;
 }
 
 /**
- * Calculates the diameter using a bfs.\n\n
+ * Computes the minimum number of flights or the minimum flown distance from every source to every destination.
+ * Rows are handed out to worker threads, each with its own search workspace\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V|+|E|)</b>, V -> number of nodes, E -> number of edges
+ *      <b>O(s*|E|*log(|V|) / t)</b>, s -> sources, t -> threads, V -> number of nodes, E -> number of edges
  * </pre>
- * @return diameter between all connected components.
+ * @param criterion - what the cells measure
+ * @param src - source nodes (rows)
+ * @param dest - destination nodes (columns)
+ * @param airlines - filter of the airlines to use
+ * @param threads - worker threads, 0 to use every hardware thread
+ * @return the matrix, with the time it took to compute
  */
-double Graph::diameter() {
-    nodes[1].visited = true;
-    double max = bfsDiameter(1);
-    for (int i = 1; i <= size; i++)
-        if (!nodes[i].visited){
-            nodes[i].visited = true;
-            double diameter = bfsDiameter(i);
-            if (diameter > max) max = diameter;
-        }
-    return max;
+RouteMatrix Graph::routeMatrix(RouteMatrix::Criterion criterion, const vector<int>& src, const vector<int>& dest,
+                               const AirlineMask& airlines, int threads) const {
+    auto start = chrono::steady_clock::now();
+    RouteMatrix matrix(criterion, src, dest);
+
+    if (threads <= 0) threads = (int) thread::hardware_concurrency();
+    threads = max(1, min(threads, (int) src.size()));
+
+    atomic<int> nextRow(0);
+    auto work = [&]() {
+        SearchWorkspace ws;
+        for (int i = nextRow++; i < (int) src.size(); i = nextRow++)
+            matrixRow(criterion, src[i], dest, airlines, ws, matrix.row(i));
+    };
+    vector<thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+
+    matrix.setTiming(chrono::duration<double>(chrono::steady_clock::now() - start).count(), threads);
+    return matrix;
 }
 
 /**
- * Finds the nodes that are articulation points and inserts them in res\n\n
+ * Calculates the eccentricity of every node: the largest number of flights needed to reach another airport from it.
+ * The sources are searched SOURCES_PER_PASS at a time by one bit-parallel breadth-first search, where every node
+ * carries one bit per source of the pass (the sources that reached it, and those that reached it in the last layer),
+ * so a layer advances every source of the pass with a few word operations per edge. Passes are handed out to worker
+ * threads\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O((|V| + |E|)*n)</b>, V -> number of nodes, E -> number of edges, n-> list size
+ *      <b>O(|V|/s * D*(|V|+|E|) * s/64 / t)</b>, V -> number of nodes, E -> number of edges, s -> sources per pass,
+ *      D -> diameter, t -> threads
  * </pre>
- * @param v - source node
- * @param index
- * @param res - list of articulation points
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+ * @param threads - worker threads, 0 to use every hardware thread
+ * @return eccentricity of each node (index 0 unused), 0 for a node without departures
  */
-void Graph::dfsArt(int v, int index, list<int>& res,Airline::AirlineH airlines) {
-    nodes[v].num = nodes[v].low = index++;
-    nodes[v].art = true;
-    int count = 0;
-    for (const auto& e : nodes[v].adj){
-        auto w = e.dest;
-        if(airlines.find(e.airline) != airlines.end() || airlines.empty()){
-            if (nodes[w].num == 0){
-                count++;
-                dfsArt(w,index,res,airlines);
-                nodes[v].low = min(nodes[v].low,nodes[w].low);
-                if (nodes[w].low >= nodes[v].num && std::find(res.begin(),res.end(),v) == res.end()) {
-                    if (index == 2 && count > 1) res.push_back(1);
-                    else if (index != 2 && std::find(res.begin(),res.end(),v)== res.end()) res.push_back(v);
-                }
+vector<int> Graph::eccentricities(int threads) const {
+    const int words = SOURCES_PER_PASS / 64;
+    int passes = (size + SOURCES_PER_PASS - 1) / SOURCES_PER_PASS;
+    vector<int> ecc(size+1, 0);
+
+    if (threads <= 0) threads = (int) thread::hardware_concurrency();
+    threads = max(1, min(threads, passes));
+
+    atomic<int> nextPass(0);
+    auto work = [&]() {
+        vector<uint64_t> seen((size+1) * words), frontier((size+1) * words, 0), incoming((size+1) * words, 0);
+        vector<int> active, arrived;
+        for (int pass = nextPass++; pass < passes; pass = nextPass++) {
+            int first = 1 + pass * SOURCES_PER_PASS;
+            int last = min(size, first + SOURCES_PER_PASS - 1);
+            fill(seen.begin(), seen.end(), 0);
+            active.clear();
+            for (int src = first; src <= last; src++) {
+                int bit = src - first;
+                seen[src * words + bit / 64] |= (uint64_t) 1 << (bit & 63);
+                frontier[src * words + bit / 64] |= (uint64_t) 1 << (bit & 63);
+                active.push_back(src);
+            }
+
+            for (int layer = 1; !active.empty(); layer++) {
+                arrived.clear();
+                for (int u : active)
+                    for (const Edge& e : adj(u)) {
+                        size_t from = u * words, to = e.dest * words;
+                        bool empty = true, reached = false;
+                        for (int k = 0; k < words; k++) {
+                            empty = empty && incoming[to+k] == 0;
+                            uint64_t bits = frontier[from+k] & ~seen[to+k];
+                            incoming[to+k] |= bits;
+                            reached = reached || bits != 0;
+                        }
+                        if (empty && reached) arrived.push_back(e.dest);
+                    }
+
+                for (int u : active)
+                    fill(frontier.begin() + u * words, frontier.begin() + (u+1) * words, 0);
+                uint64_t layerBits[SOURCES_PER_PASS / 64] = {};
+                for (int w : arrived)
+                    for (int k = 0; k < words; k++) {
+                        uint64_t bits = incoming[w * words + k];
+                        seen[w * words + k] |= bits;
+                        frontier[w * words + k] = bits;
+                        incoming[w * words + k] = 0;
+                        layerBits[k] |= bits;
+                    }
+                for (int k = 0; k < words; k++)
+                    for (uint64_t bits = layerBits[k]; bits != 0; bits &= bits - 1)
+                        ecc[first + k * 64 + __builtin_ctzll(bits)] = layer;
+                active.swap(arrived);
             }
-            else if (nodes[v].art)
-                nodes[v].low = min(nodes[v].low, nodes[w].num);
         }
-    }
+    };
+    vector<thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+    return ecc;
 }
 
 /**
- * Calculates the list of articulation points that exist in a specific unordered_set of airlines or in all airlines.\n\n
+ * Calculates the diameter of the network: the largest number of flights needed between two connected airports\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O((|V| + |E|)*n)</b>, V -> number of nodes, E -> number of edges, n-> list size
+ *      see eccentricities()
  * </pre>
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
- * @return The list of articulation points.
+ * @param threads - worker threads, 0 to use every hardware thread
+ * @return the diameter
  */
-list<int> Graph::articulationPoints(const Airline::AirlineH& airlines) {
-    list<int> answer;
-
-    for (int i = 1; i <= size; i++)
-        nodes[i].visited = nodes[i].art = false;
-
-    int index = 1;
-
-    for (int i = 1; i <= size; i++)
-        if (nodes[i].num == 0)
-            dfsArt(i,index,answer,airlines);
-
-    return answer;
+int Graph::diameter(int threads) const {
+    vector<int> ecc = eccentricities(threads);
+    return *max_element(ecc.begin(), ecc.end());
 }
 
 /**
- * Searches all the airlines that can be used to travel between a source and dest with a certain user input of airlines(or none).\n\n
+ * Runs a breadth-first search (flights) or a Dijkstra (km) from src over the routes, or over the reversed routes to
+ * find how far every node is from reaching src\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|E|)</b> E -> number of edges of source node
+ *      <b>O(|V|+|E|)</b> for flights, <b>O(|E|*log(|V|))</b> for km, V -> number of nodes, E -> number of edges
  * </pre>
  * @param src - source node
- * @param dest - final node
- * @param airlines - unordered_set of airlines that without user input is empty, if has user input only uses those specific airlines.
- * @return vector of the possible airlines to use to travel from src to dest
+ * @param forward - follow the routes (true) or the reversed routes (false)
+ * @param km - weigh the routes by their distance instead of counting them
+ * @param dist - receives the distance of every node, INF if unreachable
+ * @param ws - search workspace that holds the traversal state
+ * @return the largest finite distance (the eccentricity of src)
  */
-vector<string> Graph::getAirlines(int src, int dest, Airline::AirlineH airlines) {
-    vector<string> usedAirlines;
-    for (const auto& e: nodes[src].adj)
-        if (e.dest == dest && (airlines.empty() || airlines.find(e.airline) != airlines.end()))
-            usedAirlines.push_back(e.airline.getCode());
-    return usedAirlines;
+double Graph::sweep(int src, bool forward, bool km, vector<double>& dist, SearchWorkspace& ws) const {
+    SearchWorkspace::Bounded& state = ws.bounded;
+    dist.assign(size+1, INF);
+    dist[src] = 0;
+    double ecc = 0;
+
+    if (!km) {
+        vector<int>& q = state.forwardFrontier;
+        q.assign(1, src);
+        for (size_t head = 0; head < q.size(); head++) {
+            int u = q[head];
+            ecc = dist[u];
+            for (const Edge& e : forward ? adj(u) : radj(u))
+                if (dist[e.dest] >= INF) {
+                    dist[e.dest] = dist[u] + 1;
+                    q.push_back(e.dest);
+                }
+        }
+        return ecc;
+    }
+
+    DAryHeap<double>& q = ws.queue;
+    q.clear();
+    q.insert(src, 0);
+    while (!q.empty()) {
+        int u = q.removeMin();
+        ecc = dist[u];
+        for (const Edge& e : forward ? adj(u) : radj(u)) {
+            double d = dist[u] + e.distance;
+            if (d >= dist[e.dest]) continue;
+            dist[e.dest] = d;
+            q.push(e.dest, d);
+        }
+    }
+    return ecc;
 }
 
 /**
- * Prints a possible path from a source airport to a target airport\n\n
- *  * <b>Complexity\n</b>
+ * Calculates the exact diameter of the network (the longest of the shortest routes between two connected airports)
+ * with a directed iFUB (iterative fringe upper bound). Searches forwards and backwards from the airport with the
+ * most routes give, for every airport x of its strongly connected component, B(x) (flights from x to the hub) and
+ * F(x) (flights from the hub to x), so d(x,y) <= B(x) + F(y). A double sweep from the airports farthest from the hub
+ * gives a first lower bound. The fringe is then processed from the farthest airports inwards: a forward search from
+ * each x in decreasing B(x) and a backward search to each y in decreasing F(y), each raising the lower bound, until
+ * the lower bound reaches 2t, t being the next B or F value, which bounds every pair not yet searched. Airports
+ * outside the component of the hub are searched forwards and backwards directly\n\n
+ * <b>Complexity\n</b>
  * <pre>
- *      <b>O(n*m)</b>, n -> path size , m -> possibleAirlines size
+ *      <b>O(k*(|V|+|E|))</b> (<b>O(k*|E|*log(|V|))</b> for km), k -> searches (up to 2*|V| in the worst case, usually a few)
  * </pre>
- * @param path - visited nodes during the path
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+ * @param km - weigh the routes by their distance (true) or count flights (false)
+ * @param ws - search workspace that holds the traversal state
+ * @param searches - receives the number of searches used
+ * @return the diameter, in flights or in km
  */
-void Graph::printPath(vector<int> path, const Airline::AirlineH& airlines) {
-    for (int i = 0; i < path.size()-1; i++){
-        auto possibleAirlines = getAirlines(path[i],path[i+1],airlines);
-        printf("\033[1m\033[46m %s \033[0m", nodes[path[i]].airport.getCode().c_str());
-        cout <<" --- (";
-        for (int j = 0; j < possibleAirlines.size()-1; j++)
-            printf("\033[1m\033[32m %s \033[0m |",possibleAirlines[j].c_str());
-        printf("\033[1m\033[32m %s \033[0m",possibleAirlines[possibleAirlines.size()-1].c_str());
-        cout << ") --- ";
+double Graph::ifubDiameter(bool km, SearchWorkspace& ws, int& searches) const {
+    ws.resize(size+1);
+    searches = 0;
+
+    int hub = 0;
+    size_t routes = 0;
+    for (int v = 1; v <= size; v++)
+        if (adj(v).size() + radj(v).size() > routes) {
+            hub = v;
+            routes = adj(v).size() + radj(v).size();
+        }
+    if (hub == 0) return 0;
+
+    vector<double> from, to, dist;   // F and B of the hub
+    double lower = max(sweep(hub, true, km, from, ws), sweep(hub, false, km, to, ws));
+    searches += 2;
+
+    // double sweep: forwards from the airport farthest from reaching the hub, backwards to the one farthest from it
+    int far = hub, farTo = hub;
+    for (int v = 1; v <= size; v++) {
+        if (from[v] < INF && from[v] > from[far]) far = v;
+        if (to[v] < INF && to[v] > to[farTo]) farTo = v;
+    }
+    lower = max(lower, sweep(farTo, true, km, dist, ws));
+    lower = max(lower, sweep(far, false, km, dist, ws));
+    searches += 2;
+
+    vector<pair<double, int>> fringe;   // (bound, node) of the forward searches (node) and backward ones (-node)
+    for (int v = 1; v <= size; v++) {
+        if (from[v] < INF && to[v] < INF) {
+            fringe.emplace_back(to[v], v);
+            fringe.emplace_back(from[v], -v);
+            continue;
+        }
+        if (adj(v).size() > 0) {
+            lower = max(lower, sweep(v, true, km, dist, ws));
+            searches++;
+        }
+        if (radj(v).size() > 0) {
+            lower = max(lower, sweep(v, false, km, dist, ws));
+            searches++;
+        }
+    }
+
+    sort(fringe.begin(), fringe.end(), greater<>());
+    for (const auto& [bound, node] : fringe) {
+        if (lower >= 2 * bound) break;
+        lower = max(lower, sweep(abs(node), node > 0, km, dist, ws));
+        searches++;
     }
-    printf("\033[1m\033[46m %s \033[0m\n\n", nodes[path[path.size()-1]].airport.getCode().c_str());
+    return lower;
 }
 
 /**
- * Calculates (using bfs) and prints most optimal path of flights(least amount of flights)\n\n
+ * Runs Tarjan's algorithm over the undirected view of the routes flown by the airlines (a route in either direction
+ * connects its two airports), with an explicit stack instead of recursion. Every call starts from a clean state, so
+ * consecutive calls with different airline filters are independent. In one pass it finds the articulation points
+ * (airports whose removal disconnects others), the bridges (routes whose removal disconnects their airports) and the
+ * biconnected component of every route\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O((|V|+|E|)*p)</b>, V -> number of nodes , E-> number of edges, p-> possibleAirlines size
+ *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
  * </pre>
- * @param nrPath
- * @param start - source node
- * @param end - final node
- * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @return articulation points, bridges and biconnected components
  */
-void Graph::printPathsByFlights(int& nrPath, int start, int end, const Airline::AirlineH& airlines) {
-    vector<int> path;
-    vector<vector<int> > paths;
+Graph::Biconnectivity Graph::biconnectivity(const AirlineMask& airlines, SearchWorkspace& ws) const {
+    ws.depthFirst.resize(size+1);
+    SearchWorkspace::DepthFirst& state = ws.depthFirst;
+    Biconnectivity res;
+
+    // undirected routes, one per pair of airports, as an adjacency list of (neighbour, route)
+    vector<int> start(size+2, 0), stamp(size+1, 0), lower(size+2, 0);
+    vector<pair<int, int>> neighbours;
+    for (int v = 1; v <= size; v++) {
+        start[v] = (int) neighbours.size();
+        for (const EdgeRange& range : {adj(v), radj(v)})
+            for (const Edge& e : range) {
+                int w = e.dest;
+                if (w == v || stamp[w] == v || !airlines.acceptsAny(airlinesOf(e))) continue;
+                stamp[w] = v;
+                neighbours.emplace_back(w, -1);
+                if (w > v) lower[w+1]++;
+            }
+    }
+    start[size+1] = (int) neighbours.size();
+
+    // number each route from its lower airport, and hand the number to the higher one
+    for (int v = 1; v <= size; v++)
+        lower[v+1] += lower[v];
+    vector<pair<int, int>> handed(lower[size+1]);   // (lower airport, route), grouped by higher airport
+    for (int v = 1; v <= size; v++)
+        for (int i = start[v]; i < start[v+1]; i++) {
+            int w = neighbours[i].first;
+            if (w < v) continue;
+            neighbours[i].second = (int) res.routes.size();
+            handed[lower[w]++] = {v, (int) res.routes.size()};
+            res.routes.emplace_back(v, w);
+        }
+    vector<int> route(size+1);
+    for (int v = 1; v <= size; v++) {
+        for (int j = lower[v-1]; j < lower[v]; j++)   // lower[v] now ends the group of v
+            route[handed[j].first] = handed[j].second;
+        for (int i = start[v]; i < start[v+1]; i++)
+            if (neighbours[i].first < v) neighbours[i].second = route[neighbours[i].first];
+    }
 
-    bfsPath(start,airlines);
-    findPaths(paths,path,end);
+    for (int v = 1; v <= size; v++) {
+        state.num[v] = state.low[v] = 0;
+        state.art[v] = false;
+    }
+    res.component.assign(res.routes.size(), -1);
+
+    struct Frame {
+        int v;
+        int route;   // route from the parent, -1 for a root
+        int next;    // next position of the adjacency list of v to explore
+    };
+    vector<Frame> stack;
+    vector<int> routes;   // routes of the biconnected components being explored
+    int index = 0;
+
+    for (int root = 1; root <= size; root++) {
+        if (state.num[root] != 0 || start[root] == start[root+1]) continue;
+        state.num[root] = state.low[root] = ++index;
+        stack.push_back({root, -1, start[root]});
+        int children = 0;
+
+        while (!stack.empty()) {
+            Frame& f = stack.back();
+            int v = f.v;
+            if (f.next < start[v+1]) {
+                auto [w, k] = neighbours[f.next++];
+                if (k == f.route) continue;
+                if (state.num[w] == 0) {
+                    routes.push_back(k);
+                    state.num[w] = state.low[w] = ++index;
+                    if (v == root) children++;
+                    stack.push_back({w, k, start[w]});
+                }
+                else if (state.num[w] < state.num[v]) {
+                    routes.push_back(k);
+                    state.low[v] = min(state.low[v], state.num[w]);
+                }
+                continue;
+            }
 
-    Supervisor supervisor;
-    auto map = supervisor.getMap();
-    for (auto v : paths) {
-        reverse(v.begin(), v.end());
-        cout << " Trajeto nº" << ++nrPath << ": ";
-        printPath(v,airlines);
+            int route = f.route;
+            stack.pop_back();
+            if (stack.empty()) break;
+            int parent = stack.back().v;
+            state.low[parent] = min(state.low[parent], state.low[v]);
+            if (state.low[v] < state.num[parent]) continue;
+
+            if (parent != root) state.art[parent] = true;
+            if (state.low[v] > state.num[parent]) res.bridges.push_back(res.routes[route]);
+            int k;
+            do {
+                k = routes.back();
+                routes.pop_back();
+                res.component[k] = res.nrComponents;
+            } while (k != route);
+            res.nrComponents++;
+        }
+        if (children > 1) state.art[root] = true;
     }
+
+    for (int v = 1; v <= size; v++)
+        if (state.art[v]) res.articulationPoints.push_back(v);
+    return res;
 }
 
 /**
- * Calculates and prints the most optimal paths based on distance of nodes using the dijkstra algorithm.\n\n
+ * Calculates the list of articulation points that exist in a specific unordered_set of airlines or in all airlines.\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(log(|V|)*p)</b>, V -> number of nodes , p -> possibleAirlines size
+ *      <b>O(|V| + |E|)</b>, V -> number of nodes, E -> number of edges
  * </pre>
- * @param nrPath
- * @param start - source node
- * @param end  - final node
  * @param airlines - unordered set of airlines to use (if empty, use all airlines)
+ * @param ws - search workspace that holds the traversal state
+ * @return The list of articulation points.
  */
-void Graph::printPathsByDistance(int& nrPath, int start, int end, const Airline::AirlineH& airlines) {
-    Node node = dijkstra(start,end,airlines);
+list<int> Graph::articulationPoints(const Airline::AirlineH& airlines, SearchWorkspace& ws) const {
+    vector<int> points = biconnectivity(compileFilter(airlines), ws).articulationPoints;
+    return list<int>(points.begin(), points.end());
+}
 
-    if (node.parents.empty()) {
-        cout << " Não existem voos\n\n";
-        return;
+/**
+ * Searches all the airlines that can be used to travel between a source and dest with a certain user input of airlines(or none).\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|E| + a)</b> E -> number of edges of source node, a -> airlines of the route
+ * </pre>
+ * @param src - source node
+ * @param dest - final node
+ * @param airlines - filter of the airlines to use
+ * @return vector of the possible airlines to use to travel from src to dest
+ */
+vector<string> Graph::getAirlines(int src, int dest, const AirlineMask& airlines) const {
+    vector<string> usedAirlines;
+    for (const auto& e: adj(src)) {
+        if (e.dest != dest) continue;
+        for (int a : airlinesOf(e))
+            if (airlines.accepts(a))
+                usedAirlines.push_back(this->airlines[a].getCode());
+        break;
     }
-
-    cout << " Trajeto nº" << ++nrPath << ": ";
-    printPath(node.parents,airlines);
-
+    return usedAirlines;
 }
-
-
@@ -4,64 +4,159 @@
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <list>
 #include <queue>
 #include <iostream>
 #include <stack>
 #include <cmath>
 #include <set>
+#include <map>
 #include <algorithm>
 #include <climits>
 #include <utility>
+#include <memory>
 #include "airport.h"
 #include "airline.h"
-#include "minHeap.h"
-
-#define INF (INT_MAX/2)
+#include "dAryHeap.h"
+#include "airlineMask.h"
+#include "searchWorkspace.h"
+#include "routeMatrix.h"
+#include "coordinates.h"
 
 using namespace std;
 
 class Graph {
-
+public:
+    // Route between two airports, shared by every airline that flies it
     struct Edge {
         int dest{};
-        Airline airline;
+        int firstAirline{};           // operating airlines are csr().edgeAirlines[firstAirline .. firstAirline+nrAirlines-1]
+        int nrAirlines{};
         double distance{};
     };
 
+    // One row of flights.csv, staged until buildCSR() merges it into its route
+    struct Flight {
+        int src{};
+        int dest{};
+        int airline{};                // dense airline id, see getAirline()
+        double distance{};
+    };
+
+    // CSR arrays of the graph, either owned by it or living in a mapped snapshot
+    struct CSRView {
+        const int* offsets = nullptr;         // edges of node v are edges[offsets[v]] .. edges[offsets[v+1]-1]
+        const Edge* edges = nullptr;
+        int nrEdges = 0;
+        const int* edgeAirlines = nullptr;    // airline slices of the edges
+        int nrFlights = 0;
+        const int* reverseOffsets = nullptr;  // incoming edges of node v are reverseEdges[reverseOffsets[v]] ..
+        const Edge* reverseEdges = nullptr;   // (dest is the source of the route)
+    };
+
+private:
     struct Node {
-        list <Edge> adj;
         Airport airport = Airport("");
-        bool visited;
-        double distance;
-        vector<int> parents;
-        int num=0;
-        int low;
-        bool art;
+        int city = -1;                // interned (country, city) of the airport, see getCity()
+        int country = -1;             // interned country of the airport, see getCountry()
     };
 
     int size;
     vector<Node> nodes;
+    Coordinates coordinates;          // position of each node, for the batch distance kernels
+    vector<int> offsets;              // edges of node v are edges[offsets[v]] .. edges[offsets[v+1]-1]
+    vector<Edge> edges;               // contiguous edge array (CSR), grouped by source node, one edge per route
+    vector<int> edgeAirlines;         // airline ids of every edge, each edge owns a contiguous slice
+    vector<int> reverseOffsets;       // same layout for the incoming edges, grouped by target node
+    vector<Edge> reverseEdges;
+    vector<Flight> pending;           // flights added since the last buildCSR()
+    vector<Airline> airlines;         // airline of each dense airline id
+    unordered_map<string, int> idAirlines;
+    vector<pair<string, string>> cities;           // (country, city) of each interned city id
+    map<pair<string, string>, int> idCities;
+    vector<string> countries;                      // name of each interned country id
+    unordered_map<string, int> idCountries;
+
+    CSRView mapped;                      // CSR arrays of a mapped snapshot, used instead of the owned ones when set
+    shared_ptr<const void> mapping;      // keeps the mapped snapshot alive
+
+    const int* csrOffsets() const;
+    const Edge* csrEdges() const;
+    const int* csrEdgeAirlines() const;
+    const int* csrReverseOffsets() const;
+    const Edge* csrReverseEdges() const;
+    void matrixRow(RouteMatrix::Criterion criterion, int src, const vector<int>& dest, const AirlineMask& airlines,
+                   SearchWorkspace& ws, double* row) const;
+    double sweep(int src, bool forward, bool km, vector<double>& dist, SearchWorkspace& ws) const;
 
 public:
 
+    struct EdgeRange {
+        const Edge* first;
+        const Edge* last;
+        const Edge* begin() const {return first;}
+        const Edge* end() const {return last;}
+        size_t size() const {return last - first;}
+    };
+
+    struct AirlineRange {
+        const int* first;
+        const int* last;
+        const int* begin() const {return first;}
+        const int* end() const {return last;}
+        size_t size() const {return last - first;}
+    };
+
     explicit Graph(int nodes);
 
-    void addEdge(int src, int dest, Airline airline, double distance);
+    void addEdge(int src, int dest, int airline, double distance);
+    void addEdges(const vector<Flight>& flights);
     void addAirport(int src, Airport airport);
-
-    vector<Node> getNodes() const;
+    void addAirline(int id, Airline airline);
+    void buildCSR();
+    void adoptCSR(shared_ptr<const void> owner, const CSRView& arrays);
+    CSRView csr() const;
+
+    const vector<Node>& getNodes() const;
+    const Coordinates& getCoordinates() const;
+    const Airport& getAirport(int v) const;
+    int getSize() const;
+    EdgeRange adj(int v) const;
+    EdgeRange radj(int v) const;
+    EdgeRange allEdges() const;
+    int nrEdges() const;
+    AirlineRange airlinesOf(const Edge& e) const;
+    int totalFlights() const;
+    int departures(int v) const;
+    int nrAirlines() const;
+    const Airline& getAirline(int id) const;
+    int getAirlineId(const string& code) const;
+    AirlineMask compileFilter(const Airline::AirlineH& airlines) const;
+    int nrCities() const;
+    int nrCountries() const;
+    const pair<string, string>& getCity(int id) const;
+    const string& getCountry(int id) const;
     static double distance(double lat1, double lon1, double lat2, double lon2);
 
-    int nrFlights(int src, int dest, Airline::AirlineH airlines);
-    int airlineFlights(const string& airline);
-
-    vector<pair<int, string>> flightsPerAirport();
-    vector<pair<int, string>> airlinesPerAirport();
-
-    Airport::AirportH listAirports(int nI, int max);
-    Airport::CityH2 listCities(int nI, int max);
-    set<string> listCountries(int nI, int max);
+    int nrFlights(int src, int dest, const AirlineMask& airlines, SearchWorkspace& ws) const;
+    int nrFlights(const vector<int>& src, const vector<int>& dest, const AirlineMask& airlines, SearchWorkspace& ws,
+                  vector<pair<int, int>>& pairs) const;
+    int airlineFlights(const string& airline) const;
+
+
+    // Airports, cities and countries first reached with each number of flights
+    struct Reach {
+        struct Layer {
+            int airports = 0, cities = 0, countries = 0;
+        };
+        vector<int> airports;     // nodes reached, nearest first
+        vector<int> cities;       // interned ids of their cities, in the order they were first reached
+        vector<int> countries;    // interned ids of their countries, in the order they were first reached
+        vector<Layer> layers;     // layers[k-1] counts what was first reached with k flights
+    };
+    Reach reach(int src, int max, SearchWorkspace& ws) const;
+    Reach tally(const vector<pair<int, int>>& reached) const;
 
     struct PairStringHash{
         int operator()(const pair<string,string> &b) const {
@@ -76,25 +171,33 @@ public:
         }
     };
     typedef unordered_set<pair<string, string>, PairStringHash, PairStringHash> PairH;
-    PairH airportsFromAirport(int source);
-    unordered_set<string> airlinesFromAirport(int i);
-    Airport::CityH2 targetsFromAirport(int i);
-    unordered_set<string> countriesFromAirport(int i);
-
-    void bfsPath(int src, Airline::AirlineH airlines);
-    void findPaths(vector<vector<int>>& paths,vector<int>& path,int v);
-
-    Node dijkstra(int src, int dest, Airline::AirlineH airlines);
-
-    double bfsDiameter(int v);
-    double diameter();
-
-    void dfsArt(int v, int index,list<int> &res, Airline::AirlineH airlines);
-    list<int> articulationPoints(const Airline::AirlineH& airlines);
+    PairH airportsFromAirport(int source) const;
+    unordered_set<string> airlinesFromAirport(int i) const;
+    Airport::CityH2 targetsFromAirport(int i) const;
+    unordered_set<string> countriesFromAirport(int i) const;
+
+    void bfsPath(int src, const AirlineMask& airlines, SearchWorkspace& ws) const;
+
+    double aStar(int src, int dest, const AirlineMask& airlines, SearchWorkspace& ws) const;
+    double minDistance(const vector<int>& src, const vector<int>& dest, const AirlineMask& airlines, SearchWorkspace& ws,
+                       vector<pair<int, int>>& pairs) const;
+    RouteMatrix routeMatrix(RouteMatrix::Criterion criterion, const vector<int>& src, const vector<int>& dest,
+                            const AirlineMask& airlines, int threads = 0) const;
+
+    vector<int> eccentricities(int threads = 0) const;
+    int diameter(int threads = 0) const;
+    double ifubDiameter(bool km, SearchWorkspace& ws, int& searches) const;
+
+    struct Biconnectivity {
+        vector<int> articulationPoints;        // in increasing order
+        vector<pair<int, int>> bridges;        // routes (u, v), u < v, whose removal disconnects u from v
+        vector<pair<int, int>> routes;         // routes (u, v), u < v, flown in either direction
+        vector<int> component;                 // biconnected component of each route
+        int nrComponents = 0;
+    };
+    Biconnectivity biconnectivity(const AirlineMask& airlines, SearchWorkspace& ws) const;
+    list<int> articulationPoints(const Airline::AirlineH& airlines, SearchWorkspace& ws) const;
 
-    vector<string> getAirlines(int src, int dest, Airline::AirlineH airlines);
-    void printPath(vector<int>,const Airline::AirlineH&);
-    void printPathsByFlights(int& nrPath, int start, int end, const Airline::AirlineH& airlines);
-    void printPathsByDistance(int& nrPath, int start, int end, const Airline::AirlineH& airlines);
+    vector<string> getAirlines(int src, int dest, const AirlineMask& airlines) const;
 };
 #endif //GRAPH_H
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "hopMatrix.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+
+#define HOPS_MAGIC "RENAIRHM"
+#define HOPS_VERSION 1
+#define HOPS_UNREACHABLE 255
+
+namespace {
+    struct HopsHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t nrNodes;
+        DataStamp stamp;
+    };
+}
+
+HopMatrix::HopMatrix(int size) : size(size), data(nullptr) {}
+
+int HopMatrix::getSize() const {return size;}
+
+const uint8_t* HopMatrix::row(int src) const {
+    return data + (size_t) (src - 1) * size;
+}
+
+/**
+ * Runs a breadth-first search from every node, handing the sources out to worker threads\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|*(|V|+|E|) / t)</b>, V -> number of nodes, E -> number of edges, t -> threads
+ * </pre>
+ * @param graph - loaded graph
+ * @param threads - worker threads, 0 to use every hardware thread
+ * @return the matrix
+ */
+shared_ptr<HopMatrix> HopMatrix::build(const Graph& graph, int threads) {
+    int n = graph.getSize();
+    shared_ptr<HopMatrix> matrix(new HopMatrix(n));
+    matrix->cells.assign((size_t) n * n, HOPS_UNREACHABLE);
+    matrix->data = matrix->cells.data();
+
+    if (threads <= 0) threads = (int) thread::hardware_concurrency();
+    threads = max(1, min(threads, n));
+
+    atomic<int> nextSource(1);
+    auto work = [&]() {
+        vector<int> queue(n);
+        for (int src = nextSource++; src <= n; src = nextSource++) {
+            uint8_t* hops = matrix->cells.data() + (size_t) (src - 1) * n;
+            hops[src-1] = 0;
+            queue[0] = src;
+            for (int head = 0, tail = 1; head < tail; head++) {
+                int u = queue[head];
+                uint8_t next = hops[u-1] + 1 < HOPS_UNREACHABLE ? hops[u-1] + 1 : HOPS_UNREACHABLE - 1;
+                for (const auto& e : graph.adj(u))
+                    if (hops[e.dest-1] == HOPS_UNREACHABLE) {
+                        hops[e.dest-1] = next;
+                        queue[tail++] = e.dest;
+                    }
+            }
+        }
+    };
+    vector<thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+    return matrix;
+}
+
+/**
+ * Maps a matrix written by write() and checks that it is complete, of the current version and built from the
+ * current CSV files\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param path - path of the file
+ * @param stamp - stamp of the CSV files the matrix must have been built from
+ * @param nrNodes - number of nodes of the graph
+ * @return the matrix, or nullptr if it is missing, corrupt or stale
+ */
+shared_ptr<HopMatrix> HopMatrix::open(const string& path, const DataStamp& stamp, int nrNodes) {
+    shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file || file->size() != sizeof(HopsHeader) + (size_t) nrNodes * nrNodes) return nullptr;
+
+    HopsHeader header{};
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, HOPS_MAGIC, 8) != 0 || header.version != HOPS_VERSION) return nullptr;
+    if (!(header.stamp == stamp) || (int) header.nrNodes != nrNodes) return nullptr;
+
+    shared_ptr<HopMatrix> matrix(new HopMatrix(nrNodes));
+    matrix->file = file;
+    matrix->data = (const uint8_t*) file->data() + sizeof(HopsHeader);
+    return matrix;
+}
+
+/**
+ * Writes the matrix next to its final path and then renames it, so a reader never sees a half-written file\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|²)</b>, V -> number of nodes
+ * </pre>
+ * @param path - path of the file
+ * @param stamp - stamp of the CSV files the graph was built from
+ * @return true if the file was written
+ */
+bool HopMatrix::write(const string& path, const DataStamp& stamp) const {
+    HopsHeader header{};
+    memcpy(header.magic, HOPS_MAGIC, 8);
+    header.version = HOPS_VERSION;
+    header.nrNodes = size;
+    header.stamp = stamp;
+
+    string tmp = path + ".tmp";
+    ofstream out(tmp, ios::binary | ios::trunc);
+    if (!out) return false;
+    out.write((const char*) &header, sizeof(header));
+    out.write((const char*) data, (streamsize) ((size_t) size * size));
+    out.close();
+    if (!out) {
+        remove(tmp.c_str());
+        return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @param src - source node
+ * @param dest - target node
+ * @return minimum number of flights from src to dest, -1 if unreachable
+ */
+int HopMatrix::hops(int src, int dest) const {
+    uint8_t h = row(src)[dest-1];
+    return h == HOPS_UNREACHABLE ? -1 : h;
+}
+
+/**
+ * Finds the minimum number of flights from any source to any (other) target, like Graph::nrFlights, by looking
+ * the pairs up\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(s*d)</b>, s -> sources, d -> targets
+ * </pre>
+ * @param src - source nodes
+ * @param dest - target nodes
+ * @param pairs - receives the pairs (source, target) at the minimum number of flights, sources first
+ * @return minimum number of flights, 0 if no target can be reached
+ */
+int HopMatrix::nrFlights(const vector<int>& src, const vector<int>& dest, vector<pair<int, int>>& pairs) const {
+    pairs.clear();
+    int best = HOPS_UNREACHABLE;
+    for (int s : src) {
+        if (s < 1 || s > size) continue;
+        const uint8_t* hops = row(s);
+        for (int d : dest) {
+            if (d < 1 || d > size || d == s || hops[d-1] == HOPS_UNREACHABLE || hops[d-1] > best) continue;
+            if (hops[d-1] < best) {
+                best = hops[d-1];
+                pairs.clear();
+            }
+            pairs.emplace_back(s, d);
+        }
+    }
+    return best == HOPS_UNREACHABLE ? 0 : best;
+}
+
+/**
+ * @param src - source node
+ * @param max - number of flights
+ * @return (node, flights) of the nodes other than src that can be reached with at most max flights, nearest first
+ */
+vector<pair<int, int>> HopMatrix::reach(int src, int max) const {
+    vector<int> count(HOPS_UNREACHABLE + 1, 0);
+    const uint8_t* hops = row(src);
+    for (int v = 0; v < size; v++)
+        count[hops[v]]++;
+    vector<int> next(HOPS_UNREACHABLE + 1, 0);
+    for (int h = 1; h < HOPS_UNREACHABLE; h++)
+        next[h+1] = next[h] + (h <= max ? count[h] : 0);
+
+    vector<pair<int, int>> res(next[min(max, HOPS_UNREACHABLE - 1) + 1]);
+    for (int v = 1; v <= size; v++) {
+        int h = hops[v-1];
+        if (v != src && h != HOPS_UNREACHABLE && h >= 1 && h <= max) res[next[h]++] = {v, h};
+    }
+    return res;
+}
+
+/**
+ * @param src - source node
+ * @return the largest minimum number of flights from src to another reachable node
+ */
+int HopMatrix::eccentricity(int src) const {
+    int res = 0;
+    const uint8_t* hops = row(src);
+    for (int v = 0; v < size; v++)
+        if (hops[v] != HOPS_UNREACHABLE && hops[v] > res) res = hops[v];
+    return res;
+}
+
+/**
+ * @return the largest minimum number of flights between two connected airports
+ */
+int HopMatrix::diameter() const {
+    int res = 0;
+    for (size_t i = 0; i < (size_t) size * size; i++)
+        if (data[i] != HOPS_UNREACHABLE && data[i] > res) res = data[i];
+    return res;
+}
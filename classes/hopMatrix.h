@@ -0,0 +1,40 @@
+#ifndef HOPMATRIX_H
+#define HOPMATRIX_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "graph.h"
+#include "snapshot.h"
+#include "mappedFile.h"
+
+using namespace std;
+
+// Minimum number of flights between every pair of airports (every airline allowed), one byte per pair. Built with
+// one breadth-first search per airport spread over every hardware thread, and written to a file stamped with the
+// CSV files it came from that is mapped on the next start
+class HopMatrix {
+public:
+    static shared_ptr<HopMatrix> build(const Graph& graph, int threads = 0);
+    static shared_ptr<HopMatrix> open(const string& path, const DataStamp& stamp, int nrNodes);
+    bool write(const string& path, const DataStamp& stamp) const;
+
+    int hops(int src, int dest) const;   // -1 if unreachable
+    int nrFlights(const vector<int>& src, const vector<int>& dest, vector<pair<int, int>>& pairs) const;
+    vector<pair<int, int>> reach(int src, int max) const;   // (node, flights) of the others at most max flights away
+    int eccentricity(int src) const;   // most flights needed to reach another node from src
+    int diameter() const;
+    int getSize() const;
+
+private:
+    explicit HopMatrix(int size);
+    const uint8_t* row(int src) const;
+
+    int size;
+    vector<uint8_t> cells;            // row-major, cell (src, dest) is cells[(src-1)*size + dest-1], 255 if unreachable
+    shared_ptr<MappedFile> file;      // file the cells are mapped from instead, if it was read
+    const uint8_t* data;              // cells, either owned or mapped
+};
+
+#endif //HOPMATRIX_H
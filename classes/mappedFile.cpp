@@ -0,0 +1,40 @@
+#include "mappedFile.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Maps a whole file read-only into memory\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>, pages are only read when touched
+ * </pre>
+ * @param path - path of the file
+ * @return the mapping, or nullptr if the file does not exist or cannot be mapped
+ */
+shared_ptr<MappedFile> MappedFile::open(const string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    return shared_ptr<MappedFile>(new MappedFile((const char*) data, st.st_size));
+}
+
+MappedFile::MappedFile(const char* data, size_t size) : bytes(data), length(size) {}
+
+MappedFile::~MappedFile() {
+    munmap((void*) bytes, length);
+}
+
+const char* MappedFile::data() const {return bytes;}
+size_t MappedFile::size() const {return length;}
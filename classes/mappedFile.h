@@ -0,0 +1,25 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <memory>
+
+using namespace std;
+
+// Read-only memory mapping of a whole file, unmapped when the last owner releases it
+class MappedFile {
+public:
+    static shared_ptr<MappedFile> open(const string& path);
+    ~MappedFile();
+
+    const char* data() const;
+    size_t size() const;
+
+private:
+    MappedFile(const char* data, size_t size);
+
+    const char* bytes;
+    size_t length;
+};
+
+#endif //MAPPEDFILE_H
@@ -2,12 +2,35 @@
 
 /**
  * Initializes the supervisor\n
+ * @param options - optional engines the supervisor should prepare
  */
-Menu::Menu() {
+Menu::Menu(const Supervisor::Options& options) {
     printf("\n");
     printf("\033[44m===========================================================\033[0m\t\t");
     cout << "\n\n" << " Bem-vindo!\n (Pressione [0] sempre que quiser voltar atrás)\n\n";
-    supervisor = new Supervisor();
+    supervisor = new Supervisor(options);
+
+    const auto& stats = supervisor->getLoadStats();
+    if (stats.snapshot)
+        printf(" Rede carregada do snapshot em %.1f ms (%d voos), índices construídos em %.1f ms\n\n",
+               stats.seconds * 1000, supervisor->getGraph().totalFlights(), stats.indexSeconds * 1000);
+    else
+        printf(" Rede carregada em %.1f ms (%ld linhas de voos lidas em %.1f ms, %.0f linhas/s, %d thread(s)), "
+               "índices construídos em %.1f ms\n\n", stats.seconds * 1000, stats.rows, stats.ingestSeconds * 1000,
+               stats.rows / stats.ingestSeconds, stats.threads, stats.indexSeconds * 1000);
+    if (stats.skippedRows > 0)
+        printf(" %ld linhas de voos ignoradas (aeroporto desconhecido)\n\n", stats.skippedRows);
+    if (stats.unknownAirlines > 0)
+        printf(" %d companhias aéreas dos voos não constam de airlines.csv\n\n", stats.unknownAirlines);
+    if (supervisor->getHierarchy())
+        printf(" Hierarquia de contração %s em %.1f ms (%d atalhos)\n\n", stats.hierarchyBuilt ? "construída" : "carregada",
+               stats.hierarchySeconds * 1000, supervisor->getHierarchy()->nrShortcuts());
+    if (supervisor->getHopMatrix())
+        printf(" Matriz de voos entre aeroportos %s em %.1f ms\n\n", stats.hopMatrixBuilt ? "construída" : "carregada",
+               stats.hopMatrixSeconds * 1000);
+    if (supervisor->getReachIndex())
+        printf(" Índice de alcance até %d voos %s em %.1f ms\n\n", REACH_LAYERS,
+               stats.reachIndexBuilt ? "construído" : "carregado", stats.reachIndexSeconds * 1000);
 }
 
 /**
@@ -82,8 +105,7 @@ void Menu::chooseSource() {
             string city = validateCity(country);
             if (city == "0") continue;
 
-            auto airportsPerCity = supervisor->getCity();
-            src = airportsPerCity[{country,city}];
+            src = supervisor->getCity().at({country,city});
 
             chooseTarget();
             return;
@@ -138,8 +160,7 @@ void Menu::chooseTarget() {
             string city = validateCity(country);
             if (city == "0") continue;
 
-            auto airportsPerCity = supervisor->getCity();
-            dest = airportsPerCity[{country,city}];
+            dest = supervisor->getCity().at({country,city});
 
             chooseAirlines(true);
             return;
@@ -199,8 +220,8 @@ void Menu::chooseAirlines(bool op) {
  * Where the result might be different.\n\n
  */
 void Menu::processOperation() {
-    Graph graph = supervisor->getGraph();
-    auto map = supervisor->getMap();
+    const Graph& graph = supervisor->getGraph();
+    RoutePrinter printer(graph);
     string option = validateOption("\n Indique o critério a usar: \n\n"
                                 " [1] Número mínimo de voos\n [2] Distância mínima percorrida\n\n Opção: ");
     if (option == "0") {
@@ -211,13 +232,14 @@ void Menu::processOperation() {
     if (option == "1"){
         printf("\n\033[1m\033[32m===============================================================\033[0m\n\n");
         int nrPath = 0, nrFlights;
+        AirlineMask mask = graph.compileFilter(airlines);
         auto flightPath = supervisor->processFlight(nrFlights,src,dest,airlines);
         if (nrFlights == INT_MAX) cout << " Não existem voos \n\n";
         else{
         for (const auto& pair : flightPath) {
             string source = pair.first;
             string target = pair.second;
-            supervisor->getGraph().printPathsByFlights(nrPath,map[source], map[target],airlines);
+            printer.printPathsByFlights(nrPath,supervisor->getId(source), supervisor->getId(target),mask,workspace);
         }
         if (nrPath != 1) cout << " No total, existem " << nrPath << " trajetos possíveis\n\n";
         else cout << " Apenas existe 1 trajeto possível\n\n";
@@ -227,12 +249,13 @@ void Menu::processOperation() {
         printf("\n\033[1m\033[32m===============================================================\033[0m\n\n");
         int nrPath = 0;
         double distance;
+        AirlineMask mask = graph.compileFilter(airlines);
         auto flightPath = supervisor->processDistance(distance,src,dest,airlines);
 
         for (const auto& pair : flightPath) {
             string source = pair.first;
             string target = pair.second;
-            supervisor->getGraph().printPathsByDistance(nrPath,map[source], map[target],airlines);
+            printer.printPathsByDistance(nrPath,supervisor->getId(source), supervisor->getId(target),mask,workspace);
         }
 
         if (nrPath != 0) cout << " A distância mínima é " << distance << " km\n\n";
@@ -244,13 +267,13 @@ void Menu::processOperation() {
 
 /**
  * Information Menu where the user can obtain certain informations about
- * airport/s airlines, countries, articulation points and diameter.\n\n
+ * airport/s airlines, countries, articulation points, diameter and critical routes.\n\n
  */
 void Menu::info(){
     string option;
     while(true){
         cout << "\n Que tipo de informação deseja ver? \n\n "
-                "[1] Aeroporto específico\n [2] Aeroportos\n [3] Companhias Aéreas\n [4] Países\n [5] Pontos de articulação\n [6] Diâmetro da rede\n\n Opção: ";
+                "[1] Aeroporto específico\n [2] Aeroportos\n [3] Companhias Aéreas\n [4] Países\n [5] Pontos de articulação\n [6] Diâmetro da rede\n [7] Diâmetro da rede em km\n [8] Rotas críticas\n\n Opção: ";
         cin >> option;
         if (option == "1")
             showAirport();
@@ -266,18 +289,36 @@ void Menu::info(){
 
         else if (option == "5"){
             chooseAirlines(false);
-            auto res = supervisor->getGraph().articulationPoints(airlines);
+            auto res = supervisor->getGraph().articulationPoints(airlines, workspace);
             cout << '\n';
             for(auto index: res){
-                auto airport=supervisor->getGraph().getNodes()[index].airport;
+                const Airport& airport = supervisor->getGraph().getAirport(index);
                 printf("\033[1m\033[32m %s\033[0m", airport.getCode().c_str());
                 cout << " : " << airport.getName() << endl;
             }
             airlines.clear();
         }
-        else if (option == "6"){
-            cout << "\n Diâmetro da rede: ";
-            printf("\033[1m\033[36m%.0f\n\033[0m", supervisor->getGraph().diameter());
+        else if (option == "6" || option == "7"){
+            bool km = option == "7";
+            int searches;
+            double diameter = supervisor->diameter(km, searches);
+            cout << "\n Diâmetro da rede" << (km ? " em km" : "") << ": ";
+            printf("\033[1m\033[36m%.*f\033[0m", km ? 1 : 0, diameter);
+            if (searches > 0) printf(" (certificado com %d pesquisas)", searches);
+            printf("\n");
+        }
+        else if (option == "8"){
+            chooseAirlines(false);
+            const Graph& graph = supervisor->getGraph();
+            auto res = graph.biconnectivity(graph.compileFilter(airlines), workspace);
+            cout << "\n Rotas cuja supressão desliga os seus aeroportos (" << res.bridges.size() << " em "
+                 << res.nrComponents << " componentes biconexas):\n\n";
+            for (const auto& [u, v] : res.bridges) {
+                printf("\033[1m\033[32m %s\033[0m <---> \033[1m\033[32m%s\033[0m", graph.getAirport(u).getCode().c_str(),
+                       graph.getAirport(v).getCode().c_str());
+                cout << " : " << graph.getAirport(u).getName() << " - " << graph.getAirport(v).getName() << endl;
+            }
+            airlines.clear();
         }
 
         else if (option == "0") {
@@ -295,32 +336,33 @@ void Menu::info(){
 /**
  * After selecting "um aeroporto específico" in Info Menu, the user will be taken to a menu with a
  * vastly amount of options to choose from to get information
- * about a single airport.(Existent Flights/Existent Airlines/Reachable Airports/Cities/Countries in 1 or Y flights)\n\n
+ * about a single airport.(Existent Flights/Existent Airlines/Reachable Airports/Cities/Countries in 1 or Y flights/Eccentricity)\n\n
  */
 void Menu::showAirport(){
     string option;
 
     while(true){
         cout << "\n A partir de um aeroporto, pretende ver:\n\n "
-                "[1] Voos existentes\n [2] Companhias aéreas existentes\n [3] Aeroportos alcançáveis\n [4] Cidades alcançáveis\n [5] Países alcançáveis\n [6] Aeroportos/cidades/países possíveis de alcançar com Y voos\n\n Opção: ";
+                "[1] Voos existentes\n [2] Companhias aéreas existentes\n [3] Aeroportos alcançáveis\n [4] Cidades alcançáveis\n [5] Países alcançáveis\n [6] Aeroportos/cidades/países possíveis de alcançar com Y voos\n [7] Excentricidade (máximo de voos até um aeroporto alcançável)\n\n Opção: ";
         cin >> option;
         string airport;
         int source;
         if (option == "1"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n";
-            auto edges = supervisor->getGraph().getNodes()[source].adj;
-            for (const auto& i: edges){
-                string target = supervisor->getGraph().getNodes()[i.dest].airport.getCode();
-                cout << " " << airport << " ---( "<< i.airline.getCode() << " )--- " <<  target << endl;
+            const Graph& graph = supervisor->getGraph();
+            for (const auto& i: graph.adj(source)){
+                string target = graph.getAirport(i.dest).getCode();
+                for (int airline : graph.airlinesOf(i))
+                    cout << " " << airport << " ---( "<< graph.getAirline(airline).getCode() << " )--- " <<  target << endl;
             }
         }
         else if (option == "2"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n";
             for (const auto& i: supervisor->getGraph().airlinesFromAirport(source)){
                 printf("\033[1m\033[35m -\033[0m");
@@ -330,7 +372,7 @@ void Menu::showAirport(){
         else if (option == "3"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n Aeroportos distintos alcancáveis a partir de " << airport << ":\n\n";
             auto airports=supervisor->getGraph().airportsFromAirport(source);
             for(const auto& a: airports){
@@ -341,7 +383,7 @@ void Menu::showAirport(){
         else if (option == "4"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n";
             for (const auto& i: supervisor->getGraph().targetsFromAirport(source)){
                 printf("\033[1m\033[36m %s \033[0m", i.second.c_str()) ;
@@ -351,7 +393,7 @@ void Menu::showAirport(){
         else if (option == "5"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n";
             for (const auto& i: supervisor->getGraph().countriesFromAirport(source)){
                 printf("\033[1m\033[32m -\033[0m");
@@ -363,6 +405,12 @@ void Menu::showAirport(){
             if (airport == "0") continue;
             showOptions(airport);
         }
+        else if (option == "7"){
+            airport = validateAirport();
+            if (airport == "0") continue;
+            cout << "\n Excentricidade de " << airport << ": ";
+            printf("\033[1m\033[36m%d\n\n\033[0m", supervisor->eccentricity(supervisor->getId(airport)));
+        }
 
         else if (option == "0")
             return;
@@ -382,6 +430,8 @@ void Menu::showAirport(){
  */
 void Menu::showOptions(const string& airport) {
     int maxFlight = customTop(" Que número máximo de voos pretende realizar: ", 63832);
+    Graph::Reach res = supervisor->reach(supervisor->getId(airport), maxFlight);
+    const Graph& graph = supervisor->getGraph();
     string option;
     while(true){
         cout << "\n O que pretende ver?\n\n"
@@ -389,25 +439,26 @@ void Menu::showOptions(const string& airport) {
         cin >> option;
 
         if (option == "1") {
-            auto res = supervisor->getGraph().listAirports(supervisor->getMap()[airport], maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar o(s) seguinte(s) aeroporto(s)" << "\n\n";
-            for(const auto& airports:res){
-                printf("\033[1m\033[32m %s \033[0m", airports.getCode().c_str());
-                cout << "- " << airports.getName() << '\n';
+            for (int v : res.airports) {
+                const Airport& a = graph.getAirport(v);
+                printf("\033[1m\033[32m %s \033[0m", a.getCode().c_str());
+                cout << "- " << a.getName() << '\n';
             }
         }
         else if (option == "2") {
-            auto res = supervisor->getGraph().listCities(supervisor->getMap()[airport], maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar a(s) seguinte(s) cidades(s)" << "\n\n";
-            for(const auto& city:res){
+            for (int id : res.cities) {
+                const auto& city = graph.getCity(id);
                 printf("\033[1m\033[32m %s \033[0m", city.second.c_str());
                 cout << "- "<< city.first << '\n';
             }
         }
         else if (option == "3"){
-            auto res = supervisor->getGraph().listCountries(supervisor->getMap()[airport], maxFlight);
+            set<string> countries;
+            for (int id : res.countries) countries.insert(graph.getCountry(id));
             cout << "\n A partir de " << airport << " é possível alcançar o(s) seguinte(s) países(s)" << "\n\n";
-            for(const auto& country:res){
+            for(const auto& country:countries){
                 printf("\033[1m\033[32m - \033[0m");
                 cout << " " << country << '\n';
             }
@@ -450,32 +501,28 @@ void Menu::showAirports(){
                 }
         }
         else if (option == "3"){
-            Graph graph = supervisor->getGraph();
             int choice = showTop(), top;
             if (choice == 1) top = 10;
             else if (choice == 2) top = 20;
             else if (choice == 3) top = customTop("\n Selecione um valor para o top: ", 3020);
             else continue;
             int j = 1;
-            for (int i = 0; i < top; i++){
+            for (const auto& airport : supervisor->getAirportStats().top(AirportStats::FLIGHTS, top)){
                 printf("\n\033[1m\033[36m %i\033[0m", j);
-                cout << ". " << graph.flightsPerAirport()[i].second
-                     << " - " << graph.flightsPerAirport()[i].first << " voos\n";
+                cout << ". " << airport.second << " - " << airport.first << " voos\n";
                 j++;
             }
         }
         else if (option == "4"){
-            Graph graph = supervisor->getGraph();
             int choice = showTop(), top;
             if (choice == 1) top = 10;
             else if (choice == 2) top = 20;
             else if (choice == 3) top = customTop("\n Selecione um valor para o top: ",3020);
             else continue;
             int j = 1;
-            for (int i = 0; i < top; i++){
+            for (const auto& airport : supervisor->getAirportStats().top(AirportStats::AIRLINES, top)){
                 printf("\n\033[1m\033[32m %i\033[0m", j);
-                cout<< ". " << graph.airlinesPerAirport()[i].second
-                    << " - " << graph.airlinesPerAirport()[i].first << " companhias aéreas\n";
+                cout<< ". " << airport.second << " - " << airport.first << " companhias aéreas\n";
                 j++;
             }
         }
@@ -598,7 +645,7 @@ void Menu::statistics() {
 
         else if (option == "5"){
             chooseAirlines(false);
-            auto res = supervisor->getGraph().articulationPoints(airlines);
+            auto res = supervisor->getGraph().articulationPoints(airlines, workspace);
             cout << "\n Existem" ;
             printf("\033[1m\033[36m %lu \033[0m", res.size()) ;
             cout << "pontos de articulação\n";
@@ -667,7 +714,7 @@ void Menu::numberAirports() {
         else if (option == "2"){
             string country = validateCountry();
             if (country == "0") continue;
-            int count = supervisor->getNrAirportsPerCountry()[country];
+            int count = supervisor->getNrAirportsPerCountry().at(country);
 
             cout << "\n Neste país (" << country << ") existem ";
             printf("\033[1m\033[34m%i\033[0m", count);
@@ -733,23 +780,23 @@ void Menu::airportStats() {
         if (option == "1"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n Nº de voos existentes a partir de " << airport << ":";
-            printf("\033[1m\033[36m %lu \n\033[0m", supervisor->getGraph().getNodes()[source].adj.size()) ;
+            printf("\033[1m\033[36m %d \n\033[0m", supervisor->getGraph().departures(source)) ;
         }
 
         else if (option == "2"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n Nº de companhias aéreas de " << airport << ":";
-            printf("\033[1m\033[36m %lu \n\033[0m", supervisor->getGraph().airlinesFromAirport(source).size());
+            printf("\033[1m\033[36m %d \n\033[0m", supervisor->getAirportStats().airlines(source));
         }
 
         else if (option == "3"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n Nº de destinos distintos alcancáveis a partir de " << airport << ":";
             printf("\033[1m\033[36m %lu \n\033[0m", supervisor->getGraph().targetsFromAirport(source).size());
         }
@@ -757,14 +804,14 @@ void Menu::airportStats() {
         else if (option == "4"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n Nº de aeroportos distintos alcancáveis a partir de " << airport << ":";
             printf("\033[1m\033[36m %lu \n\033[0m", supervisor->getGraph().airportsFromAirport(source).size());
         }
         else if (option == "5"){
             airport = validateAirport();
             if (airport == "0") continue;
-            source = supervisor->getMap()[airport];
+            source = supervisor->getId(airport);
             cout << "\n Nº de países diferentes alcancáveis a partir de " << airport << ":";
             printf("\033[1m\033[36m %lu \n\033[0m", supervisor->getGraph().countriesFromAirport(source).size());
         }
@@ -786,29 +833,42 @@ void Menu::maxReach() {
     string airport = validateAirport();
     if (airport == "0") return;
     int maxFlight = customTop(" Que número máximo de voos pretende realizar: ", 63832);
+    vector<Graph::Reach::Layer> layers = supervisor->reachCounts(supervisor->getId(airport), maxFlight);
+    Graph::Reach::Layer total;
+    for (const auto& layer : layers) {
+        total.airports += layer.airports;
+        total.cities += layer.cities;
+        total.countries += layer.countries;
+    }
     while(true){
         cout << "\n O que pretende ver?\n\n"
-                " [1] Aeroportos\n [2] Cidades\n [3] Países\n\n Opção: ";
+                " [1] Aeroportos\n [2] Cidades\n [3] Países\n [4] Por número de voos\n\n Opção: ";
         cin >> option;
 
         if (option == "1") {
-            auto res = supervisor->getGraph().listAirports(supervisor->getMap()[airport], maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar ";
-            printf("\033[1m\033[35m%lu \033[0m", res.size());
+            printf("\033[1m\033[35m%d \033[0m", total.airports);
             cout << "aeroportos com um máximo de " << maxFlight << " voos\n";
         }
         else if (option == "2") {
-            auto res = supervisor->getGraph().listCities(supervisor->getMap()[airport], maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar ";
-            printf("\033[1m\033[32m%lu \033[0m", res.size());
+            printf("\033[1m\033[32m%d \033[0m", total.cities);
             cout << "cidades com um máximo de " << maxFlight << " voos\n";
         }
         else if (option == "3"){
-            auto res = supervisor->getGraph().listCountries(supervisor->getMap()[airport], maxFlight);
             cout << "\n A partir de " << airport << " é possível alcançar ";
-            printf("\033[1m\033[34m%lu \033[0m", res.size());
+            printf("\033[1m\033[34m%d \033[0m", total.countries);
             cout << "países com um máximo de " << maxFlight << " voos\n";
         }
+        else if (option == "4"){
+            cout << "\n A partir de " << airport << " alcança-se pela primeira vez com\n\n";
+            for (size_t k = 0; k < layers.size(); k++) {
+                const auto& layer = layers[k];
+                printf("\033[1m %2zu voo(s)\033[0m - ", k+1);
+                printf("\033[35m%d\033[0m aeroportos, \033[32m%d\033[0m cidades, \033[34m%d\033[0m países\n",
+                       layer.airports, layer.cities, layer.countries);
+            }
+        }
         else if (option == "0")
             return;
 
@@ -1004,7 +1064,12 @@ vector<string> Menu::validateLocal() {
     double radius = validateRadius();
     vector<string> local = supervisor->localAirports(latitude,longitude,radius);
     while (local.empty()){
-        cout << " Não existem aeroportos no local indicado, tente novamente\n";
+        cout << " Não existem aeroportos no local indicado. Os mais próximos são:\n\n";
+        for (const auto& [code, km] : supervisor->nearestAirports(latitude, longitude, 3)) {
+            printf("\033[1m\033[32m %s \033[0m", code.c_str());
+            printf("- %.1f km\n", km);
+        }
+        cout << "\n Tente novamente com um raio maior\n";
         latitude = validateLatitude();
         longitude = validateLongitude();
         radius = validateRadius();
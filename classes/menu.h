@@ -2,10 +2,11 @@
 #define MENU_H
 
 #include "supervisor.h"
+#include "routePrinter.h"
 
 class Menu{
 public:
-    Menu();
+    explicit Menu(const Supervisor::Options& options = Supervisor::Options());
     void init();
     static void end();
 private:
@@ -45,6 +46,7 @@ private:
     vector<string> src;
     vector<string> dest;
     Airline::AirlineH airlines;
+    SearchWorkspace workspace;
     
 };
 #endif //MENU_H
@@ -0,0 +1,163 @@
+#include "reachIndex.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+
+#define REACH_MAGIC "RENAIRRI"
+#define REACH_VERSION 1
+
+namespace {
+    struct ReachHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t nrNodes;
+        uint32_t layers;
+        DataStamp stamp;
+    };
+}
+
+ReachIndex::ReachIndex(int size) : size(size), data(nullptr) {}
+
+int ReachIndex::getSize() const {return size;}
+
+const ReachIndex::Counts& ReachIndex::at(int src, int max) const {
+    return data[(size_t) (src - 1) * REACH_LAYERS + max - 1];
+}
+
+/**
+ * Runs a search bounded to REACH_LAYERS flights from every node, handing the sources out to worker threads, and
+ * accumulates the counts of each layer\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|*(|V|+|E|) / t)</b>, V -> number of nodes, E -> number of edges, t -> threads
+ * </pre>
+ * @param graph - loaded graph
+ * @param threads - worker threads, 0 to use every hardware thread
+ * @return the index
+ */
+shared_ptr<ReachIndex> ReachIndex::build(const Graph& graph, int threads) {
+    int n = graph.getSize();
+    shared_ptr<ReachIndex> index(new ReachIndex(n));
+    index->cells.assign((size_t) n * REACH_LAYERS, Counts{0, 0, 0});
+    index->data = index->cells.data();
+
+    if (threads <= 0) threads = (int) thread::hardware_concurrency();
+    threads = max(1, min(threads, n));
+
+    atomic<int> nextSource(1);
+    auto work = [&]() {
+        SearchWorkspace ws;
+        for (int src = nextSource++; src <= n; src = nextSource++) {
+            Graph::Reach reach = graph.reach(src, REACH_LAYERS, ws);
+            Counts* row = index->cells.data() + (size_t) (src - 1) * REACH_LAYERS;
+            Counts total{0, 0, 0};
+            for (int k = 0; k < REACH_LAYERS; k++) {
+                if (k < (int) reach.layers.size()) {
+                    total.airports += reach.layers[k].airports;
+                    total.cities += reach.layers[k].cities;
+                    total.countries += reach.layers[k].countries;
+                }
+                row[k] = total;
+            }
+        }
+    };
+    vector<thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+    return index;
+}
+
+/**
+ * Maps an index written by write() and checks that it is complete, of the current version and built from the
+ * current CSV files\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param path - path of the file
+ * @param stamp - stamp of the CSV files the index must have been built from
+ * @param nrNodes - number of nodes of the graph
+ * @return the index, or nullptr if it is missing, corrupt or stale
+ */
+shared_ptr<ReachIndex> ReachIndex::open(const string& path, const DataStamp& stamp, int nrNodes) {
+    shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file || file->size() != sizeof(ReachHeader) + (size_t) nrNodes * REACH_LAYERS * sizeof(Counts))
+        return nullptr;
+
+    ReachHeader header{};
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, REACH_MAGIC, 8) != 0 || header.version != REACH_VERSION) return nullptr;
+    if (!(header.stamp == stamp) || (int) header.nrNodes != nrNodes || header.layers != REACH_LAYERS) return nullptr;
+
+    shared_ptr<ReachIndex> index(new ReachIndex(nrNodes));
+    index->file = file;
+    index->data = (const Counts*) (file->data() + sizeof(ReachHeader));
+    return index;
+}
+
+/**
+ * Writes the index next to its final path and then renames it, so a reader never sees a half-written file\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|)</b>, V -> number of nodes
+ * </pre>
+ * @param path - path of the file
+ * @param stamp - stamp of the CSV files the graph was built from
+ * @return true if the file was written
+ */
+bool ReachIndex::write(const string& path, const DataStamp& stamp) const {
+    ReachHeader header{};
+    memcpy(header.magic, REACH_MAGIC, 8);
+    header.version = REACH_VERSION;
+    header.nrNodes = size;
+    header.layers = REACH_LAYERS;
+    header.stamp = stamp;
+
+    string tmp = path + ".tmp";
+    ofstream out(tmp, ios::binary | ios::trunc);
+    if (!out) return false;
+    out.write((const char*) &header, sizeof(header));
+    out.write((const char*) data, (streamsize) ((size_t) size * REACH_LAYERS * sizeof(Counts)));
+    out.close();
+    if (!out) {
+        remove(tmp.c_str());
+        return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * Writes the reach table as CSV: one line per airport with its code and then, for every number of flights from 1
+ * to REACH_LAYERS, the airports, cities and countries reached with at most that many flights\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|)</b>, V -> number of nodes
+ * </pre>
+ * @param path - path of the file
+ * @param graph - graph the nodes belong to
+ * @return true if the file was written
+ */
+bool ReachIndex::writeCsv(const string& path, const Graph& graph) const {
+    ofstream out(path, ios::trunc);
+    if (!out) return false;
+
+    out << "Code";
+    for (int k = 1; k <= REACH_LAYERS; k++)
+        out << ",Airports" << k << ",Cities" << k << ",Countries" << k;
+    out << '\n';
+
+    for (int v = 1; v <= size; v++) {
+        out << graph.getAirport(v).getCode();
+        for (int k = 1; k <= REACH_LAYERS; k++) {
+            const Counts& counts = at(v, k);
+            out << ',' << counts.airports << ',' << counts.cities << ',' << counts.countries;
+        }
+        out << '\n';
+    }
+    out.close();
+    return !out.fail();
+}
@@ -0,0 +1,44 @@
+#ifndef REACHINDEX_H
+#define REACHINDEX_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "graph.h"
+#include "snapshot.h"
+#include "mappedFile.h"
+
+using namespace std;
+
+#define REACH_LAYERS 6
+
+// Number of airports, cities and countries that every airport reaches with at most 1..REACH_LAYERS flights (every
+// airline allowed). Built with one depth-bounded search per airport spread over every hardware thread, and written
+// to a file stamped with the CSV files it came from that is mapped on the next start
+class ReachIndex {
+public:
+    struct Counts {
+        int32_t airports;
+        int32_t cities;
+        int32_t countries;
+    };
+
+    static shared_ptr<ReachIndex> build(const Graph& graph, int threads = 0);
+    static shared_ptr<ReachIndex> open(const string& path, const DataStamp& stamp, int nrNodes);
+    bool write(const string& path, const DataStamp& stamp) const;
+    bool writeCsv(const string& path, const Graph& graph) const;
+
+    const Counts& at(int src, int max) const;   // reached with at most max flights, 1 <= max <= REACH_LAYERS
+    int getSize() const;
+
+private:
+    explicit ReachIndex(int size);
+
+    int size;
+    vector<Counts> cells;            // cell (src, max) is cells[(src-1)*REACH_LAYERS + max-1]
+    shared_ptr<MappedFile> file;     // file the cells are mapped from instead, if it was read
+    const Counts* data;              // cells, either owned or mapped
+};
+
+#endif //REACHINDEX_H
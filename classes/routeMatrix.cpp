@@ -0,0 +1,129 @@
+#include "routeMatrix.h"
+#include "graph.h"
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+#define MATRIX_MAGIC "RENAIRMX"
+#define MATRIX_VERSION 1
+
+/**
+ * RouteMatrix class constructor, with every cell unreachable
+ * @param criterion - what the cells measure
+ * @param origins - node of each row
+ * @param destinations - node of each column
+ */
+RouteMatrix::RouteMatrix(Criterion criterion, vector<int> origins, vector<int> destinations)
+        : criterion(criterion), origins(std::move(origins)), destinations(std::move(destinations)) {
+    cells.assign(this->origins.size() * this->destinations.size(), INF);
+}
+
+RouteMatrix::Criterion RouteMatrix::getCriterion() const {return criterion;}
+int RouteMatrix::rows() const {return (int) origins.size();}
+int RouteMatrix::cols() const {return (int) destinations.size();}
+const vector<int>& RouteMatrix::getOrigins() const {return origins;}
+const vector<int>& RouteMatrix::getDestinations() const {return destinations;}
+double RouteMatrix::getSeconds() const {return seconds;}
+int RouteMatrix::getThreads() const {return threads;}
+
+/**
+ * @param row - row (origin) index
+ * @param col - column (destination) index
+ * @return minimum number of flights or distance from the origin to the destination, INF if unreachable
+ */
+double RouteMatrix::at(int row, int col) const {
+    return cells[(size_t) row * destinations.size() + col];
+}
+
+/**
+ * @param row - row (origin) index
+ * @return the cols() cells of the row
+ */
+double* RouteMatrix::row(int row) {
+    return cells.data() + (size_t) row * destinations.size();
+}
+
+/**
+ * Records how long the table took to compute
+ * @param seconds - elapsed time
+ * @param threads - threads that computed it
+ */
+void RouteMatrix::setTiming(double seconds, int threads) {
+    this->seconds = seconds;
+    this->threads = threads;
+}
+
+/**
+ * @return cells computed per second
+ */
+double RouteMatrix::cellsPerSecond() const {
+    return seconds > 0 ? (double) cells.size() / seconds : 0;
+}
+
+/**
+ * Writes the table as CSV: a header with the destination codes, then one line per origin starting with its code.
+ * Flights are written as integers, distances in km with one decimal and unreachable cells are left empty\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n*m)</b>, n -> rows, m -> columns
+ * </pre>
+ * @param path - path of the file
+ * @param graph - graph the nodes belong to
+ * @return true if the file was written
+ */
+bool RouteMatrix::writeCsv(const string& path, const Graph& graph) const {
+    ofstream out(path, ios::trunc);
+    if (!out) return false;
+
+    out << (criterion == FLIGHTS ? "Flights" : "Km");
+    for (int d : destinations)
+        out << ',' << graph.getAirport(d).getCode();
+    out << '\n';
+
+    char buffer[32];
+    for (int i = 0; i < rows(); i++) {
+        out << graph.getAirport(origins[i]).getCode();
+        for (int j = 0; j < cols(); j++) {
+            out << ',';
+            double value = at(i, j);
+            if (value >= INF) continue;
+            if (criterion == FLIGHTS) snprintf(buffer, sizeof(buffer), "%d", (int) value);
+            else snprintf(buffer, sizeof(buffer), "%.1f", value);
+            out << buffer;
+        }
+        out << '\n';
+    }
+    out.close();
+    return !out.fail();
+}
+
+/**
+ * Writes the table in binary: the magic "RENAIRMX", a version, the criterion (0 = flights, 1 = km) and the number
+ * of rows and columns as 32-bit integers, the 4-byte codes (NUL padded) of the origins and of the destinations,
+ * and then the cells as row-major doubles (INF = INT_MAX/2 for unreachable)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n*m)</b>, n -> rows, m -> columns
+ * </pre>
+ * @param path - path of the file
+ * @param graph - graph the nodes belong to
+ * @return true if the file was written
+ */
+bool RouteMatrix::writeBinary(const string& path, const Graph& graph) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    uint32_t header[4] = {MATRIX_VERSION, (uint32_t) criterion, (uint32_t) rows(), (uint32_t) cols()};
+    out.write(MATRIX_MAGIC, 8);
+    out.write((const char*) header, sizeof(header));
+    for (const vector<int>* nodes : {&origins, &destinations})
+        for (int v : *nodes) {
+            char code[4] = {};   // fixed-size field, not null-terminated
+            const string& s = graph.getAirport(v).getCode();
+            memcpy(code, s.data(), min(s.size(), sizeof(code)));
+            out.write(code, sizeof(code));
+        }
+    out.write((const char*) cells.data(), (streamsize) (cells.size() * sizeof(double)));
+    out.close();
+    return !out.fail();
+}
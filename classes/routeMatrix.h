@@ -0,0 +1,44 @@
+#ifndef ROUTEMATRIX_H
+#define ROUTEMATRIX_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+// Dense origin-destination table of the minimum number of flights or the minimum flown distance, one row per
+// origin and one column per destination (row-major). Unreachable cells hold INF
+class RouteMatrix {
+public:
+    enum Criterion {FLIGHTS, DISTANCE};
+
+    RouteMatrix(Criterion criterion, vector<int> origins, vector<int> destinations);
+
+    Criterion getCriterion() const;
+    int rows() const;
+    int cols() const;
+    const vector<int>& getOrigins() const;
+    const vector<int>& getDestinations() const;
+    double at(int row, int col) const;
+    double* row(int row);
+
+    void setTiming(double seconds, int threads);
+    double getSeconds() const;
+    int getThreads() const;
+    double cellsPerSecond() const;
+
+    bool writeCsv(const string& path, const Graph& graph) const;
+    bool writeBinary(const string& path, const Graph& graph) const;
+
+private:
+    Criterion criterion;
+    vector<int> origins;
+    vector<int> destinations;
+    vector<double> cells;
+    double seconds = 0;       // time spent computing the table
+    int threads = 0;          // threads that computed it
+};
+
+#endif //ROUTEMATRIX_H
@@ -0,0 +1,148 @@
+#include "routePrinter.h"
+
+/**
+ * RoutePrinter class constructor
+ * @param graph - loaded network whose nodes are resolved to airport codes
+ */
+RoutePrinter::RoutePrinter(const Graph& graph) : graph(graph) {}
+
+/**
+ * Stores in paths all possible paths to node v, following the parents left in the workspace by a search.\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b> n -> paths size
+ * </pre>
+ * @param paths - vector of paths that are possible
+ * @param path - current path
+ * @param v - target node
+ * @param ws - search workspace filled by Graph::bfsPath or Graph::aStar
+ */
+void RoutePrinter::findPaths(vector<vector<int>>& paths, vector<int>& path, int v, const SearchWorkspace& ws) {
+
+    if (v == -1) {
+        if (find(paths.begin(),paths.end(),path) == paths.end())
+            paths.push_back(path);
+        return;
+    }
+
+    for (auto par : ws.parents[v]) {
+        path.push_back(v);
+        findPaths(paths,path, par, ws);
+        path.pop_back();
+    }
+}
+
+/**
+ * Calculates (using bfs) every path with the least amount of flights from start to end\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|+|E|+n)</b>, V -> number of nodes , E-> number of edges, n -> size of the paths
+ * </pre>
+ * @param start - source node
+ * @param end - final node
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @return paths as sequences of nodes from start to end
+ */
+vector<vector<int>> RoutePrinter::pathsByFlights(int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const {
+    vector<int> path;
+    vector<vector<int>> paths;
+
+    graph.bfsPath(start,airlines,ws);
+    findPaths(paths,path,end,ws);
+
+    for (auto& p : paths)
+        reverse(p.begin(), p.end());
+    return paths;
+}
+
+/**
+ * Calculates (using A*) every path with the minimum flown distance from start to end\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|E|*log(|V|)+n)</b>, V -> number of nodes , E-> number of edges, n -> size of the paths
+ * </pre>
+ * @param start - source node
+ * @param end - final node
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ * @return paths as sequences of nodes from start to end (empty if there is none)
+ */
+vector<vector<int>> RoutePrinter::pathsByDistance(int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const {
+    vector<int> path;
+    vector<vector<int>> paths;
+    if (graph.aStar(start,end,airlines,ws) >= INF) return paths;
+    findPaths(paths,path,end,ws);
+
+    for (auto& p : paths)
+        reverse(p.begin(), p.end());
+    return paths;
+}
+
+/**
+ * Prints a possible path from a source airport to a target airport\n\n
+ *  * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n*m)</b>, n -> path size , m -> possibleAirlines size
+ * </pre>
+ * @param path - visited nodes during the path
+ * @param airlines - filter of the airlines to use
+ */
+void RoutePrinter::printPath(const vector<int>& path, const AirlineMask& airlines) const {
+    if (path.empty()) return;
+    for (size_t i = 0; i + 1 < path.size(); i++){
+        auto possibleAirlines = graph.getAirlines(path[i],path[i+1],airlines);
+        printf("\033[1m\033[46m %s \033[0m", graph.getAirport(path[i]).getCode().c_str());
+        cout <<" --- (";
+        for (size_t j = 0; j < possibleAirlines.size(); j++)
+            printf(j + 1 < possibleAirlines.size() ? "\033[1m\033[32m %s \033[0m |" : "\033[1m\033[32m %s \033[0m",
+                   possibleAirlines[j].c_str());
+        cout << ") --- ";
+    }
+    printf("\033[1m\033[46m %s \033[0m\n\n", graph.getAirport(path.back()).getCode().c_str());
+}
+
+/**
+ * Calculates (using bfs) and prints most optimal path of flights(least amount of flights)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O((|V|+|E|)*p)</b>, V -> number of nodes , E-> number of edges, p-> possibleAirlines size
+ * </pre>
+ * @param nrPath
+ * @param start - source node
+ * @param end - final node
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ */
+void RoutePrinter::printPathsByFlights(int& nrPath, int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const {
+    for (const auto& path : pathsByFlights(start,end,airlines,ws)) {
+        cout << " Trajeto nº" << ++nrPath << ": ";
+        printPath(path,airlines);
+    }
+}
+
+/**
+ * Calculates and prints every path with the minimum flown distance\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|E|*log(|V|)+n*p)</b>, V -> number of nodes , E-> number of edges, n -> size of the paths, p -> possibleAirlines size
+ * </pre>
+ * @param nrPath
+ * @param start - source node
+ * @param end  - final node
+ * @param airlines - filter of the airlines to use
+ * @param ws - search workspace that holds the traversal state
+ */
+void RoutePrinter::printPathsByDistance(int& nrPath, int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const {
+    vector<vector<int>> paths = pathsByDistance(start,end,airlines,ws);
+
+    if (paths.empty()) {
+        cout << " Não existem voos\n\n";
+        return;
+    }
+
+    for (const auto& path : paths) {
+        cout << " Trajeto nº" << ++nrPath << ": ";
+        printPath(path,airlines);
+    }
+}
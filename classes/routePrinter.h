@@ -0,0 +1,27 @@
+#ifndef ROUTEPRINTER_H
+#define ROUTEPRINTER_H
+
+#include <vector>
+#include <iostream>
+#include "graph.h"
+
+using namespace std;
+
+class RoutePrinter {
+public:
+    explicit RoutePrinter(const Graph& graph);
+
+    vector<vector<int>> pathsByFlights(int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const;
+    vector<vector<int>> pathsByDistance(int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const;
+
+    void printPath(const vector<int>& path, const AirlineMask& airlines) const;
+    void printPathsByFlights(int& nrPath, int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const;
+    void printPathsByDistance(int& nrPath, int start, int end, const AirlineMask& airlines, SearchWorkspace& ws) const;
+
+private:
+    static void findPaths(vector<vector<int>>& paths, vector<int>& path, int v, const SearchWorkspace& ws);
+
+    const Graph& graph;
+};
+
+#endif //ROUTEPRINTER_H
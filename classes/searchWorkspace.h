@@ -0,0 +1,121 @@
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include "dAryHeap.h"
+
+#define INF (INT_MAX/2)
+
+using namespace std;
+
+// Per-query traversal state, kept outside of the graph so that the loaded network is never modified by a search.
+// A workspace can be reused by consecutive queries; concurrent queries must each use their own workspace.
+// The state is grouped by the engine that owns it, and every engine only sizes and resets its own group.
+struct SearchWorkspace {
+    // Searches that reset every node when they start: Graph::bfsPath, aStar, minDistance and sweep
+    vector<bool> visited;
+    vector<double> distance;
+    vector<vector<int>> parents;   // predecessors of each node on its best routes (-1 for the source)
+    vector<int> batch;             // nodes handed to a batch distance kernel, and the distances it returned (aStar)
+    vector<double> batchDistance;
+    DAryHeap<double> queue;        // priority queue of a distance search
+
+    // Searches that stop early and only reset the nodes they reached: Graph::nrFlights for one pair, reach and
+    // matrixRow (and the breadth-first queue of sweep)
+    struct Bounded {
+        vector<int> forward;           // hops from the source (-1 = not reached)
+        vector<int> backward;          // hops to the target of a bidirectional search (-1 = not reached)
+        vector<double> distance;       // distances of a row of a route matrix (INF = not reached)
+        vector<bool> settled;
+        vector<bool> target;           // destinations of a row of a route matrix
+        vector<int> touched;           // nodes to reset once the search ends
+        vector<int> forwardFrontier, backwardFrontier, nextFrontier;
+
+        void resize(int n);
+    } bounded;
+
+    // Multi-source searches, one bit per source in the bitsets of every node: Graph::nrFlights and minDistance
+    // over sets of airports
+    struct MultiSource {
+        vector<bool> target;
+        vector<uint64_t> origins;      // sources that reached each node: all of them (at its distance),
+        vector<uint64_t> fresh;        // those new in the current layer
+        vector<uint64_t> incoming;     // and those arriving in the next layer
+        vector<int> frontier, nextFrontier;
+        vector<int> nearest;           // airport of every source at the distance of each node (-1 = more than one)
+        vector<double> secondDistance; // while it is a single airport: distance from the nearest other airports
+        vector<uint64_t> second;       // and their sources
+        vector<bool> secondSettled;
+        vector<uint64_t> found;        // sources at the minimum distance of each target that was reached
+
+        void resize(int n);
+    } multiSource;
+
+    // Upward searches from both ends of a ContractionHierarchy query, which only reset the nodes they reached
+    struct Hierarchy {
+        vector<double> forwardDistance;   // INF = not reached
+        vector<double> backwardDistance;
+        vector<int> previous;          // predecessor of each node on its upward path from the source (-1 for the source)
+        vector<int> next;              // successor of each node on its upward path to the target (-1 for the target)
+        vector<int> touched;
+        DAryHeap<double> forwardQueue, backwardQueue;
+
+        void resize(int n);
+    } hierarchy;
+
+    // Depth-first numbering of Graph::biconnectivity
+    struct DepthFirst {
+        vector<int> num;
+        vector<int> low;
+        vector<bool> art;
+
+        void resize(int n);
+    } depthFirst;
+
+    void resize(int n);        // Make room for (at least) n nodes in the searches that reset every node
+};
+
+// ----------------------------------------------
+
+inline void SearchWorkspace::resize(int n) {
+    if ((int) visited.size() >= n) return;
+    visited.resize(n);
+    distance.resize(n);
+    parents.resize(n);
+    queue.reserve(n);
+}
+
+inline void SearchWorkspace::Bounded::resize(int n) {
+    if ((int) forward.size() >= n) return;
+    forward.resize(n, -1);
+    backward.resize(n, -1);
+    distance.resize(n, INF);
+    settled.resize(n, false);
+    target.resize(n, false);
+}
+
+inline void SearchWorkspace::MultiSource::resize(int n) {
+    if ((int) target.size() >= n) return;
+    target.resize(n, false);
+}
+
+inline void SearchWorkspace::Hierarchy::resize(int n) {
+    if ((int) forwardDistance.size() >= n) return;
+    forwardDistance.resize(n, INF);
+    backwardDistance.resize(n, INF);
+    previous.resize(n);
+    next.resize(n);
+    forwardQueue.reserve(n);
+    backwardQueue.reserve(n);
+}
+
+inline void SearchWorkspace::DepthFirst::resize(int n) {
+    if ((int) num.size() >= n) return;
+    num.resize(n);
+    low.resize(n);
+    art.resize(n);
+}
+
+#endif //SEARCHWORKSPACE_H
@@ -0,0 +1,251 @@
+#include "snapshot.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <climits>
+#include <sys/stat.h>
+
+#define SNAPSHOT_MAGIC "RENAIRSN"
+#define SNAPSHOT_VERSION 4
+
+static_assert(sizeof(Graph::Edge) == 24, "snapshot edges are stored as 24-byte records");
+
+/**
+ * Reads the size and modification time of the three CSV files
+ * @param airports - path of airports.csv
+ * @param airlines - path of airlines.csv
+ * @param flights - path of flights.csv
+ * @return stamp of the files (zeros for files that do not exist)
+ */
+DataStamp DataStamp::of(const string& airports, const string& airlines, const string& flights) {
+    DataStamp stamp{};
+    const string* paths[3] = {&airports, &airlines, &flights};
+    for (int i = 0; i < 3; i++) {
+        struct stat st{};
+        if (stat(paths[i]->c_str(), &st) != 0) continue;
+        stamp.sizes[i] = st.st_size;
+        stamp.mtimes[i] = st.st_mtime;
+    }
+    return stamp;
+}
+
+bool DataStamp::operator==(const DataStamp& other) const {
+    return memcmp(sizes, other.sizes, sizeof(sizes)) == 0 && memcmp(mtimes, other.mtimes, sizeof(mtimes)) == 0;
+}
+
+Snapshot::Snapshot(shared_ptr<MappedFile> file) : file(std::move(file)) {
+    header = (const Header*) this->file->data();
+}
+
+/**
+ * Maps a snapshot and checks that it is complete, of the current version, built from the current CSV files and
+ * consistent (see valid)\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + |E| + |F| + n)</b>, V -> number of nodes, E -> number of edges, F -> number of flights, n -> number of airlines
+ * </pre>
+ * @param path - path of the snapshot
+ * @param stamp - stamp of the CSV files the snapshot must have been built from
+ * @return the snapshot, or nullptr if it is missing, corrupt or stale
+ */
+shared_ptr<Snapshot> Snapshot::open(const string& path, const DataStamp& stamp) {
+    auto file = MappedFile::open(path);
+    if (!file || file->size() < sizeof(Header)) return nullptr;
+
+    auto h = (const Header*) file->data();
+    if (memcmp(h->magic, SNAPSHOT_MAGIC, 8) != 0 || h->version != SNAPSHOT_VERSION) return nullptr;
+    if (h->end != file->size() || !(h->stamp == stamp)) return nullptr;
+
+    auto snapshot = shared_ptr<Snapshot>(new Snapshot(file));
+    if (!snapshot->valid()) return nullptr;
+    return snapshot;
+}
+
+// Checks that a section of count records of the given size starts 8-byte aligned and ends before limit
+static bool fits(uint64_t offset, uint64_t count, size_t size, uint64_t limit) {
+    return offset % 8 == 0 && offset <= limit && count <= (limit - offset) / size;
+}
+
+// Checks that the offsets of the nodes 0..nrNodes+1 never decrease and stay within the edges, and that every edge
+// points to a node and to a slice of the airline array
+static bool validCSR(const int* offsets, const Graph::Edge* edges, int nrNodes, int nrEdges, int nrFlights) {
+    if (offsets[0] < 0 || offsets[nrNodes+1] > nrEdges) return false;
+    for (int v = 0; v <= nrNodes; v++)
+        if (offsets[v] > offsets[v+1]) return false;
+    for (int i = 0; i < nrEdges; i++) {
+        const Graph::Edge& e = edges[i];
+        if (e.dest < 1 || e.dest > nrNodes || e.firstAirline < 0 || e.nrAirlines < 0) return false;
+        if (e.firstAirline > nrFlights - e.nrAirlines) return false;
+    }
+    return true;
+}
+
+/**
+ * Checks every section and every index stored in the mapping against the file: the sections lie inside it in
+ * order, the string offsets fall in the string table, the CSR offsets and edges are in range (see validCSR) and
+ * the airline slices hold interned airlines. A damaged file whose stamp still matches is then rebuilt from the CSV
+ * files instead of being read out of bounds\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + |E| + |F| + n)</b>, V -> number of nodes, E -> number of edges, F -> number of flights, n -> number of airlines
+ * </pre>
+ * @return true if the snapshot can be read safely
+ */
+bool Snapshot::valid() const {
+    const Header& h = *header;
+    if (h.nrAirports >= INT_MAX - 2 || h.nrAirlines > INT_MAX || h.nrEdges > INT_MAX || h.nrFlights > INT_MAX) return false;
+    uint64_t nrOffsets = (uint64_t) h.nrAirports + 2;
+    if (h.strings < sizeof(Header) || h.strings % 8 != 0 || h.strings >= h.airports) return false;
+    if (!fits(h.airports, (uint64_t) h.nrAirports + 1, sizeof(AirportRecord), h.airlines) ||
+        !fits(h.airlines, h.nrAirlines, sizeof(AirlineRecord), h.offsets) ||
+        !fits(h.offsets, nrOffsets, sizeof(int), h.edges) ||
+        !fits(h.edges, h.nrEdges, sizeof(Graph::Edge), h.edgeAirlines) ||
+        !fits(h.edgeAirlines, h.nrFlights, sizeof(int), h.reverseOffsets) ||
+        !fits(h.reverseOffsets, nrOffsets, sizeof(int), h.reverseEdges) ||
+        !fits(h.reverseEdges, h.nrEdges, sizeof(Graph::Edge), h.end)) return false;
+
+    const char* data = file->data();
+    uint64_t nrChars = h.airports - h.strings;   // the table ends with the terminator of its last string
+    if (data[h.airports - 1] != '\0') return false;
+    auto airports = (const AirportRecord*) (data + h.airports);
+    for (uint32_t i = 1; i <= h.nrAirports; i++) {
+        const AirportRecord& r = airports[i];
+        if (r.code >= nrChars || r.name >= nrChars || r.city >= nrChars || r.country >= nrChars) return false;
+    }
+    auto airlines = (const AirlineRecord*) (data + h.airlines);
+    for (uint32_t i = 0; i < h.nrAirlines; i++) {
+        const AirlineRecord& r = airlines[i];
+        if (r.code >= nrChars || r.name >= nrChars || r.callSign >= nrChars || r.country >= nrChars) return false;
+    }
+
+    int nrNodes = (int) h.nrAirports, nrEdges = (int) h.nrEdges, nrFlights = (int) h.nrFlights;
+    if (!validCSR((const int*) (data + h.offsets), (const Graph::Edge*) (data + h.edges), nrNodes, nrEdges, nrFlights) ||
+        !validCSR((const int*) (data + h.reverseOffsets), (const Graph::Edge*) (data + h.reverseEdges), nrNodes,
+                  nrEdges, nrFlights)) return false;
+    auto edgeAirlines = (const int*) (data + h.edgeAirlines);
+    for (int i = 0; i < nrFlights; i++)
+        if (edgeAirlines[i] < 0 || edgeAirlines[i] >= (int) h.nrAirlines) return false;
+    return true;
+}
+
+// Appends bytes to the file image, padded so that the next section starts 8-byte aligned
+static uint64_t appendSection(vector<char>& image, const void* data, size_t size) {
+    uint64_t offset = image.size();
+    image.insert(image.end(), (const char*) data, (const char*) data + size);
+    image.resize((image.size() + 7) & ~(size_t) 7, 0);
+    return offset;
+}
+
+/**
+ * Compiles the loaded graph into a snapshot file. The file is written next to its final path and then renamed,
+ * so a reader never maps a half-written snapshot\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + |E| + |F| + n)</b>, V -> number of nodes, E -> number of edges, F -> number of flights, n -> number of airlines
+ * </pre>
+ * @param path - path of the snapshot
+ * @param stamp - stamp of the CSV files the graph was built from
+ * @param graph - loaded graph (after buildCSR)
+ * @return true if the snapshot was written
+ */
+bool Snapshot::write(const string& path, const DataStamp& stamp, const Graph& graph) {
+    vector<char> strings;
+    auto intern = [&strings](const string& s) {
+        auto offset = (uint32_t) strings.size();
+        strings.insert(strings.end(), s.begin(), s.end());
+        strings.push_back('\0');
+        return offset;
+    };
+
+    vector<AirportRecord> airports(graph.getSize() + 1, AirportRecord{});
+    for (int i = 1; i <= graph.getSize(); i++) {
+        const Airport& a = graph.getAirport(i);
+        airports[i] = {intern(a.getCode()), intern(a.getName()), intern(a.getCity()), intern(a.getCountry()),
+                       a.getLatitude(), a.getLongitude()};
+    }
+
+    vector<AirlineRecord> airlines(graph.nrAirlines());
+    for (int i = 0; i < graph.nrAirlines(); i++) {
+        const Airline& a = graph.getAirline(i);
+        airlines[i] = {intern(a.getCode()), intern(a.getName()), intern(a.getCallSign()), intern(a.getCountry())};
+    }
+
+    Header header{};
+    memcpy(header.magic, SNAPSHOT_MAGIC, 8);
+    header.version = SNAPSHOT_VERSION;
+    header.nrAirports = graph.getSize();
+    header.nrAirlines = graph.nrAirlines();
+    header.nrEdges = graph.nrEdges();
+    header.nrFlights = graph.totalFlights();
+    header.stamp = stamp;
+
+    vector<char> image;
+    appendSection(image, &header, sizeof(header));
+    header.strings = appendSection(image, strings.data(), strings.size());
+    header.airports = appendSection(image, airports.data(), airports.size() * sizeof(AirportRecord));
+    header.airlines = appendSection(image, airlines.data(), airlines.size() * sizeof(AirlineRecord));
+    Graph::CSRView csr = graph.csr();
+    header.offsets = appendSection(image, csr.offsets, (graph.getSize() + 2) * sizeof(int));
+    header.edges = appendSection(image, csr.edges, csr.nrEdges * sizeof(Graph::Edge));
+    header.edgeAirlines = appendSection(image, csr.edgeAirlines, csr.nrFlights * sizeof(int));
+    header.reverseOffsets = appendSection(image, csr.reverseOffsets, (graph.getSize() + 2) * sizeof(int));
+    header.reverseEdges = appendSection(image, csr.reverseEdges, csr.nrEdges * sizeof(Graph::Edge));
+    header.end = image.size();
+    memcpy(image.data(), &header, sizeof(header));
+
+    string tmp = path + ".tmp";
+    ofstream out(tmp, ios::binary | ios::trunc);
+    if (!out) return false;
+    out.write(image.data(), (streamsize) image.size());
+    out.close();
+    if (!out) {
+        remove(tmp.c_str());
+        return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+const char* Snapshot::text(uint32_t offset) const {
+    return file->data() + header->strings + offset;
+}
+
+int Snapshot::nrAirports() const {return (int) header->nrAirports;}
+int Snapshot::nrAirlines() const {return (int) header->nrAirlines;}
+
+/**
+ * @param id - airport id (graph node), in 1..nrAirports()
+ * @return airport stored in the snapshot
+ */
+Airport Snapshot::airport(int id) const {
+    auto r = (const AirportRecord*) (file->data() + header->airports) + id;
+    return {text(r->code), text(r->name), text(r->city), text(r->country), r->latitude, r->longitude};
+}
+
+/**
+ * @param id - dense airline id, in 0..nrAirlines()-1
+ * @return airline stored in the snapshot
+ */
+Airline Snapshot::airline(int id) const {
+    auto r = (const AirlineRecord*) (file->data() + header->airlines) + id;
+    return {text(r->code), text(r->name), text(r->callSign), text(r->country)};
+}
+
+/**
+ * Makes the graph traverse the CSR arrays of the mapping directly; the mapping stays alive as long as the graph uses it\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param graph - graph with as many nodes as the snapshot has airports
+ */
+void Snapshot::attach(Graph& graph) const {
+    Graph::CSRView csr;
+    csr.offsets = (const int*) (file->data() + header->offsets);
+    csr.edges = (const Graph::Edge*) (file->data() + header->edges);
+    csr.nrEdges = (int) header->nrEdges;
+    csr.edgeAirlines = (const int*) (file->data() + header->edgeAirlines);
+    csr.nrFlights = (int) header->nrFlights;
+    csr.reverseOffsets = (const int*) (file->data() + header->reverseOffsets);
+    csr.reverseEdges = (const Graph::Edge*) (file->data() + header->reverseEdges);
+    graph.adoptCSR(file, csr);
+}
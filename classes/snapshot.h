@@ -0,0 +1,61 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "graph.h"
+#include "mappedFile.h"
+
+using namespace std;
+
+// Sizes and modification times of the CSV files a snapshot (or any other precomputed file) was built from
+struct DataStamp {
+    uint64_t sizes[3];
+    uint64_t mtimes[3];
+
+    static DataStamp of(const string& airports, const string& airlines, const string& flights);
+    bool operator==(const DataStamp& other) const;
+};
+
+// Compiled binary image of the network (string table, airport table, airline table and forward and reverse CSR
+// edges with precomputed distances and their airline slices) that is written once and then mapped read-only on startup
+class Snapshot {
+public:
+    struct AirportRecord {
+        uint32_t code, name, city, country;   // offsets in the string table
+        double latitude, longitude;
+    };
+    struct AirlineRecord {
+        uint32_t code, name, callSign, country;
+    };
+
+    static shared_ptr<Snapshot> open(const string& path, const DataStamp& stamp);
+    static bool write(const string& path, const DataStamp& stamp, const Graph& graph);
+
+    int nrAirports() const;
+    int nrAirlines() const;
+    Airport airport(int id) const;         // id in 1..nrAirports()
+    Airline airline(int id) const;         // id in 0..nrAirlines()-1
+    void attach(Graph& graph) const;       // make the graph traverse the mapped CSR arrays
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t nrAirports, nrAirlines, nrEdges, nrFlights;
+        DataStamp stamp;
+        uint64_t strings, airports, airlines, offsets, edges, edgeAirlines;   // section offsets in the file
+        uint64_t reverseOffsets, reverseEdges, end;
+    };
+
+    explicit Snapshot(shared_ptr<MappedFile> file);
+    bool valid() const;
+    const char* text(uint32_t offset) const;
+
+    shared_ptr<MappedFile> file;
+    const Header* header;
+};
+
+#endif //SNAPSHOT_H
@@ -0,0 +1,187 @@
+#include "spatialIndex.h"
+
+#define CHORD_SLACK 1e-9    // keeps airports right on the radius for the exact check, despite rounding
+
+/**
+ * Builds the tree over every airport of the graph\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|*log(|V|))</b>, V -> number of nodes
+ * </pre>
+ * @param graph - loaded graph
+ */
+SpatialIndex::SpatialIndex(const Graph& graph) {
+    points.reserve(graph.getSize());
+    for (int v = 1; v <= graph.getSize(); v++) {
+        const Airport& airport = graph.getAirport(v);
+        points.push_back(toPoint(airport.getLatitude(), airport.getLongitude(), v));
+    }
+    build(0, (int) points.size(), 0);
+
+    coordinates = Coordinates((int) points.size());
+    for (int i = 0; i < (int) points.size(); i++) {
+        const Airport& airport = graph.getAirport(points[i].node);
+        coordinates.set(i, airport.getLatitude(), airport.getLongitude());
+    }
+}
+
+/**
+ * @param latitude - latitude in degrees
+ * @param longitude - longitude in degrees
+ * @param node - node of the point, -1 for a query
+ * @return the point of the unit sphere at those coordinates
+ */
+SpatialIndex::Point SpatialIndex::toPoint(double latitude, double longitude, int node) {
+    Point p{{0, 0, 0}, node};
+    Coordinates::unitVector(latitude, longitude, p.coords[0], p.coords[1], p.coords[2]);
+    return p;
+}
+
+/**
+ * @return squared straight-line distance between two points of the unit sphere
+ */
+double SpatialIndex::chord2(const Point& a, const Point& b) {
+    double res = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        double d = a.coords[axis] - b.coords[axis];
+        res += d * d;
+    }
+    return res;
+}
+
+/**
+ * Places the median of points[lo, hi) on axis depth % 3 in the middle and builds both halves the same way\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n*log(n))</b>, n -> hi - lo
+ * </pre>
+ * @param lo - first point of the subtree
+ * @param hi - one past the last point of the subtree
+ * @param depth - depth of the subtree
+ */
+void SpatialIndex::build(int lo, int hi, int depth) {
+    if (hi - lo <= 1) return;
+    int mid = (lo + hi) / 2, axis = depth % 3;
+    nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi,
+                [axis](const Point& a, const Point& b) {return a.coords[axis] < b.coords[axis];});
+    build(lo, mid, depth + 1);
+    build(mid + 1, hi, depth + 1);
+}
+
+/**
+ * Collects the points of a subtree whose squared chord to q is at most bound, skipping the side of a splitting plane
+ * that is farther than that
+ * @param lo - first point of the subtree
+ * @param hi - one past the last point of the subtree
+ * @param depth - depth of the subtree
+ * @param q - query point
+ * @param bound - squared chord of the radius
+ * @param res - receives the positions of the points found
+ */
+void SpatialIndex::radiusSearch(int lo, int hi, int depth, const Point& q, double bound, vector<int>& res) const {
+    if (lo >= hi) return;
+    int mid = (lo + hi) / 2, axis = depth % 3;
+    const Point& p = points[mid];
+    if (chord2(p, q) <= bound) res.push_back(mid);
+
+    double diff = q.coords[axis] - p.coords[axis];
+    if (diff < 0) {
+        radiusSearch(lo, mid, depth + 1, q, bound, res);
+        if (diff * diff <= bound) radiusSearch(mid + 1, hi, depth + 1, q, bound, res);
+    }
+    else {
+        radiusSearch(mid + 1, hi, depth + 1, q, bound, res);
+        if (diff * diff <= bound) radiusSearch(lo, mid, depth + 1, q, bound, res);
+    }
+}
+
+/**
+ * Keeps in best (a max-heap of squared chord and point) the k points of a subtree nearest to q, skipping the side of
+ * a splitting plane that is farther than the k-th nearest point found so far
+ * @param lo - first point of the subtree
+ * @param hi - one past the last point of the subtree
+ * @param depth - depth of the subtree
+ * @param q - query point
+ * @param k - number of points to keep
+ * @param best - nearest points found so far
+ */
+void SpatialIndex::nearestSearch(int lo, int hi, int depth, const Point& q, int k,
+                                 vector<pair<double, int>>& best) const {
+    if (lo >= hi) return;
+    int mid = (lo + hi) / 2, axis = depth % 3;
+    const Point& p = points[mid];
+    pair<double, int> candidate = {chord2(p, q), mid};
+    if ((int) best.size() < k) {
+        best.push_back(candidate);
+        push_heap(best.begin(), best.end());
+    }
+    else if (candidate < best.front()) {
+        pop_heap(best.begin(), best.end());
+        best.back() = candidate;
+        push_heap(best.begin(), best.end());
+    }
+
+    double diff = q.coords[axis] - p.coords[axis];
+    int nearLo = diff < 0 ? lo : mid + 1, nearHi = diff < 0 ? mid : hi;
+    int farLo = diff < 0 ? mid + 1 : lo, farHi = diff < 0 ? hi : mid;
+    nearestSearch(nearLo, nearHi, depth + 1, q, k, best);
+    if ((int) best.size() < k || diff * diff < best.front().first)
+        nearestSearch(farLo, farHi, depth + 1, q, k, best);
+}
+
+/**
+ * Calculates the airports that exist in a radius of a certain coordinate\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(sqrt(|V|) + n*log(n))</b> on average, V -> number of nodes, n -> airports near the radius
+ * </pre>
+ * @param latitude - latitude of the center of the circumference
+ * @param longitude - longitude of the center of the circumference
+ * @param radius - radius of the circumference, in km
+ * @return nodes of the airports whose distance to the center is at most radius, by id
+ */
+vector<int> SpatialIndex::withinRadius(double latitude, double longitude, double radius) const {
+    vector<int> res;
+    if (radius < 0) return res;
+    Point q = toPoint(latitude, longitude, -1);
+    double chord = 2 * sin(min(radius / (2 * EARTH_RADIUS), M_PI / 2));
+
+    vector<int> candidates;
+    radiusSearch(0, (int) points.size(), 0, q, chord * chord + CHORD_SLACK, candidates);
+    vector<double> km(candidates.size());
+    coordinates.distances(latitude, longitude, candidates.data(), (int) candidates.size(), km.data());
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (km[i] <= radius) res.push_back(points[candidates[i]].node);
+    sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * Calculates the airports nearest to a certain coordinate\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(log(|V|) + k*log(k))</b> on average, V -> number of nodes
+ * </pre>
+ * @param latitude - latitude of the coordinate
+ * @param longitude - longitude of the coordinate
+ * @param k - number of airports
+ * @return (node, distance in km) of the k airports nearest to the coordinate, nearest first
+ */
+vector<pair<int, double>> SpatialIndex::nearest(double latitude, double longitude, int k) const {
+    vector<pair<int, double>> res;
+    if (k <= 0) return res;
+    Point q = toPoint(latitude, longitude, -1);
+
+    vector<pair<double, int>> best;
+    best.reserve(k);
+    nearestSearch(0, (int) points.size(), 0, q, k, best);
+    sort_heap(best.begin(), best.end());
+
+    vector<int> found;
+    for (const auto& candidate : best) found.push_back(candidate.second);
+    vector<double> km(found.size());
+    coordinates.distances(latitude, longitude, found.data(), (int) found.size(), km.data());
+    for (size_t i = 0; i < found.size(); i++)
+        res.emplace_back(points[found[i]].node, km[i]);
+    return res;
+}
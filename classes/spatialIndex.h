@@ -0,0 +1,37 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <vector>
+#include <utility>
+#include "graph.h"
+
+using namespace std;
+
+// k-d tree over the airports as points of the unit sphere, so that the straight-line (chord) distance between two
+// points grows with their great-circle distance. Subtrees whose splitting plane is farther than the chord of the
+// radius are skipped, and only the airports left are checked with the batch distance kernel
+class SpatialIndex {
+public:
+    SpatialIndex() = default;
+    explicit SpatialIndex(const Graph& graph);
+
+    vector<int> withinRadius(double latitude, double longitude, double radius) const;    // nodes, by id
+    vector<pair<int, double>> nearest(double latitude, double longitude, int k) const;   // (node, km), nearest first
+
+private:
+    struct Point {
+        double coords[3];       // unit vector of the airport
+        int node;
+    };
+
+    static Point toPoint(double latitude, double longitude, int node);
+    static double chord2(const Point& a, const Point& b);
+    void build(int lo, int hi, int depth);
+    void radiusSearch(int lo, int hi, int depth, const Point& q, double bound, vector<int>& res) const;
+    void nearestSearch(int lo, int hi, int depth, const Point& q, int k, vector<pair<double, int>>& best) const;
+
+    vector<Point> points;       // implicit tree: the median of points[lo, hi) splits it on axis depth % 3
+    Coordinates coordinates;    // position of each point of the tree, by its position in points
+};
+
+#endif //SPATIALINDEX_H
@@ -1,22 +1,64 @@
 #include "supervisor.h"
 /**
- * Default Constructor for supervisor
+ * Default Constructor for supervisor, with every option turned off
  */
-Supervisor::Supervisor() {
-    createAirports();
-    createAirlines();
-    createGraph();
+Supervisor::Supervisor() : Supervisor(Options()) {}
+
+/**
+ * Constructor for supervisor.
+ * Maps the compiled snapshot of the network if it is up to date with the CSV files; otherwise reads the CSV files
+ * and writes a new snapshot for the next start
+ * @param options - optional engines to prepare
+ */
+Supervisor::Supervisor(const Options& options) {
+    auto start = chrono::steady_clock::now();
+    DataStamp stamp = DataStamp::of(DATA_DIR "airports.csv", DATA_DIR "airlines.csv", DATA_DIR "flights.csv");
+    loadStats.snapshot = loadSnapshot(stamp);
+    if (!loadStats.snapshot) {
+        createAirports();
+        createAirlines();
+        createGraph();
+    }
+    loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (!loadStats.snapshot) Snapshot::write(DATA_DIR "renair.snap", stamp, graph);
+
+    start = chrono::steady_clock::now();
     countAirportsPerCountry();
+    spatialIndex = SpatialIndex(graph);
+    airportStats = AirportStats(graph);
+    loadStats.indexSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (options.contractionHierarchy) loadHierarchy(stamp);
+    if (options.hopMatrix) loadHopMatrix(stamp);
+    if (options.reachIndex) loadReachIndex(stamp);
 }
 
 Airport::AirportH const& Supervisor::getAirports() const {return airports;}
 Airline::AirlineH const& Supervisor::getAirlines() const {return airlines;}
 Airport::CityH const& Supervisor::getCity() const {return airportsPerCity;}
-Graph Supervisor::getGraph() const {return graph;}
-unordered_map<string,int> Supervisor::getMap() const{
-    return idAirports;
+Graph const& Supervisor::getGraph() const {return graph;}
+unordered_map<string,int> const& Supervisor::getMap() const {return idAirports;}
+map<string,int> const& Supervisor::getNrAirportsPerCountry() const {return nrAirportsPerCountry;}
+Supervisor::LoadStats const& Supervisor::getLoadStats() const {return loadStats;}
+const ContractionHierarchy* Supervisor::getHierarchy() const {return hierarchy.get();}
+const HopMatrix* Supervisor::getHopMatrix() const {return hopMatrix.get();}
+const ReachIndex* Supervisor::getReachIndex() const {return reachIndex.get();}
+AirportStats const& Supervisor::getAirportStats() const {return airportStats;}
+
+/**
+ * Gives the node of an airport without copying the id map\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param airport - airport code
+ * @return node of the airport in the graph, or 0 if there is no such airport
+ */
+int Supervisor::getId(const string& airport) const {
+    auto i = idAirports.find(airport);
+    if (i == idAirports.end()) return 0;
+    return i->second;
 }
-map<string,int> Supervisor::getNrAirportsPerCountry() const {return nrAirportsPerCountry;}
 
 /**
  * Verifies if a country is in the countries unordered_set\n\n
@@ -90,10 +132,10 @@ bool Supervisor::isValidCity(const string& country, const string& city) {
     return false;
 }
 /**
- * Calculates the airports that exist in a radius of a certain coordinate\n\n
+ * Calculates the airports that exist in a radius of a certain coordinate, with the spatial index\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V|*log(n))</b>, n -> number of airports that exist in a certain radius, V-> number of nodes
+ *      <b>O(sqrt(|V|) + n*log(n))</b> on average, n -> number of airports near the radius, V-> number of nodes
  * </pre>
  * @param latitude - latitude of the center of the circumference
  * @param longitude -longitude of the center of the circumference
@@ -102,20 +144,35 @@ bool Supervisor::isValidCity(const string& country, const string& city) {
  */
 vector<string> Supervisor::localAirports(double latitude, double longitude, double radius) {
     vector<string> localAirports;
-    double latitude1,longitude1;
-    for (const auto& node : graph.getNodes()){
-        latitude1 = node.airport.getLatitude();
-        longitude1 = node.airport.getLongitude();
-        if (Graph::distance(latitude,longitude,latitude1,longitude1) <= radius)
-            localAirports.push_back(node.airport.getCode());
-    }
+    for (int v : spatialIndex.withinRadius(latitude, longitude, radius))
+        localAirports.push_back(graph.getAirport(v).getCode());
     return localAirports;
 }
+
+/**
+ * Calculates the airports nearest to a certain coordinate, with the spatial index\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(log(|V|) + k*log(k))</b> on average, V-> number of nodes
+ * </pre>
+ * @param latitude - latitude of the coordinate
+ * @param longitude - longitude of the coordinate
+ * @param k - number of airports
+ * @return codes of the k nearest airports and their distance in km, nearest first
+ */
+vector<pair<string, double>> Supervisor::nearestAirports(double latitude, double longitude, int k) const {
+    vector<pair<string, double>> res;
+    for (const auto& [v, km] : spatialIndex.nearest(latitude, longitude, k))
+        res.emplace_back(graph.getAirport(v).getCode(), km);
+    return res;
+}
 /**
- * Calculates the smallest amount of flights possible to get to a specific airport from another airport\n\n
+ * Calculates the smallest amount of flights possible to get to a specific airport from another airport.
+ * All the pairs are answered by one search from every source at once, or looked up in the hop matrix when it is
+ * enabled and there is no airline filter\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(n*m*(|V|+|E|))</b>,n -> size of src vector, m -> size of dest vector,V -> number of nodes, E -> number of edges
+ *      <b>O((|V|+|E|)*n/64 + n*m)</b>,n -> size of src vector, m -> size of dest vector,V -> number of nodes, E -> number of edges
  * </pre>
  * @param src  - source node
  * @param dest - final node
@@ -125,54 +182,180 @@ vector<string> Supervisor::localAirports(double latitude, double longitude, doub
 list<pair<string,string>> Supervisor::processFlight(int& bestFlight, const vector<string>& src, const vector<string>& dest,
                                                     const Airline::AirlineH& airline) {
     bestFlight = INT_MAX;
-    int nrFlights;
     list<pair<string,string>> res;
-    for (const auto &s: src)
-        for (const auto &d: dest) {
-            if (s == d) continue;
-            nrFlights = graph.nrFlights(idAirports[s], idAirports[d], airline);
-            if (nrFlights != 0 && nrFlights < bestFlight) {
-                bestFlight = nrFlights;
-                res.clear();
-                res.emplace_back(s,d);
-            }
-            else if(nrFlights == bestFlight)
-                res.emplace_back(s,d);
-        }
+    AirlineMask mask = graph.compileFilter(airline);
+    vector<pair<int,int>> pairs;
+    int nrFlights = hopMatrix && mask.acceptsAll() ? hopMatrix->nrFlights(getIds(src), getIds(dest), pairs)
+                                                   : graph.nrFlights(getIds(src), getIds(dest), mask, workspace, pairs);
+    if (nrFlights == 0) return res;
+
+    bestFlight = nrFlights;
+    for (const auto& p : pairs)
+        res.emplace_back(graph.getAirport(p.first).getCode(), graph.getAirport(p.second).getCode());
     return res;
 }
 
 /**
- * Calculates the smallest amount of distance needed to get to a specific airport from another airport\n\n
+ * Calculates the smallest amount of distance needed to get to a specific airport from another airport.
+ * All the pairs are answered by one search from every source at once; a single pair without an airline filter is
+ * answered by the contraction hierarchy when it is enabled\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(n*m*(log(|V|))</b>,n -> size of src vector, m -> size of dest vector,V -> number of nodes
+ *      <b>O(|E|*log(|V|)*n/64 + n*m)</b>,n -> size of src vector, m -> size of dest vector, V -> number of nodes, E -> number of edges
  * </pre>
  * @param src  - source node
  * @param dest - final node
  * @param airline - airlines available for use  (if empty, use all airlines)
- * @return list of all best possible paths
+ * @return list of all best possible paths (every pair if none is connected)
  */
 list<pair<string,string>> Supervisor::processDistance(double& bestDistance, const vector<string>& src, const vector<string>& dest,
                                                       const Airline::AirlineH& airline) {
-    bestDistance = MAXFLOAT;
-    double distance;
     list<pair<string,string>> res;
-    for (const auto &s: src)
-        for (const auto &d: dest) {
-            if (s == d) continue;
-            auto node = graph.dijkstra(idAirports[s],idAirports[d],airline);
-            distance = node.distance;
-            if (distance < bestDistance) {
-                bestDistance = distance;
-                res.clear();
-                res.emplace_back(s,d);
-            }
-            else if (distance == bestDistance)
-                res.emplace_back(s,d);
-        }
+    AirlineMask mask = graph.compileFilter(airline);
+    vector<int> from = getIds(src), to = getIds(dest);
+    vector<pair<int,int>> pairs;
+
+    if (hierarchy && mask.acceptsAll() && from.size() == 1 && to.size() == 1) {
+        bestDistance = from[0] == to[0] ? INF : hierarchy->distance(from[0], to[0], workspace);
+        if (from[0] != to[0]) pairs.emplace_back(from[0], to[0]);
+    }
+    else {
+        bestDistance = graph.minDistance(from, to, mask, workspace, pairs);
+        if (bestDistance >= INF)
+            for (int s : from)
+                for (int d : to)
+                    if (s != d) pairs.emplace_back(s, d);
+    }
+
+    for (const auto& p : pairs)
+        res.emplace_back(graph.getAirport(p.first).getCode(), graph.getAirport(p.second).getCode());
     return res;
 }
+
+/**
+ * @param airports - airport codes
+ * @return node of each airport (0 if there is no such airport)
+ */
+vector<int> Supervisor::getIds(const vector<string>& airports) const {
+    vector<int> ids;
+    ids.reserve(airports.size());
+    for (const auto& airport : airports)
+        ids.push_back(getId(airport));
+    return ids;
+}
+
+/**
+ * Expands a comma-separated list of airport codes and country names ("*" for every airport) into nodes\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n*|V|)</b>, n -> entries of the list, V -> number of nodes
+ * </pre>
+ * @param spec - list of airports and countries
+ * @param ids - receives the nodes, in the order of the list
+ * @return false if an entry is neither an airport nor a country
+ */
+bool Supervisor::airportsOf(const string& spec, vector<int>& ids) const {
+    ids.clear();
+    stringstream ss(spec);
+    string entry;
+    while (getline(ss, entry, ',')) {
+        if (entry.empty()) continue;
+        if (entry == "*") {
+            for (int v = 1; v <= graph.getSize(); v++) ids.push_back(v);
+        }
+        else if (getId(entry) != 0) ids.push_back(getId(entry));
+        else if (countries.count(entry)) {
+            for (int v = 1; v <= graph.getSize(); v++)
+                if (graph.getAirport(v).getCountry() == entry) ids.push_back(v);
+        }
+        else return false;
+    }
+    return !ids.empty();
+}
+
+/**
+ * Computes the minimum number of flights or the minimum flown distance between every pair of a set of origins and
+ * a set of destinations, using every hardware thread
+ * @param criterion - what the cells measure
+ * @param src - origin nodes (rows)
+ * @param dest - destination nodes (columns)
+ * @param airlines - airlines to use, empty to use all of them
+ * @return the matrix, with the time it took to compute
+ */
+RouteMatrix Supervisor::routeMatrix(RouteMatrix::Criterion criterion, const vector<int>& src, const vector<int>& dest,
+                                    const Airline::AirlineH& airlines) const {
+    return graph.routeMatrix(criterion, src, dest, graph.compileFilter(airlines));
+}
+
+/**
+ * Calculates the airports, cities and countries reachable using "max" number of flights, from the hop matrix when it
+ * is enabled\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V|)</b> with the hop matrix, <b>O(|V'| + |E'|)</b> without it, V' -> nodes at most max flights away,
+ *      E' -> their edges
+ * </pre>
+ * @param v - source node
+ * @param max - number of flights
+ * @return what can be reached using "max" number of flights, with the counts of each number of flights
+ */
+Graph::Reach Supervisor::reach(int v, int max) {
+    if (hopMatrix) return graph.tally(hopMatrix->reach(v, max));
+    return graph.reach(v, max, workspace);
+}
+
+/**
+ * Counts the airports, cities and countries first reached with each number of flights up to "max", from the reach
+ * index when it is enabled and covers "max"\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(max)</b> with the reach index, otherwise the complexity of reach()
+ * </pre>
+ * @param v - source node
+ * @param max - number of flights
+ * @return counts[k-1] of what is first reached with k flights, up to the last number of flights that reaches anything
+ */
+vector<Graph::Reach::Layer> Supervisor::reachCounts(int v, int max) {
+    if (!reachIndex || max > REACH_LAYERS) return reach(v, max).layers;
+    vector<Graph::Reach::Layer> counts;
+    ReachIndex::Counts previous{0, 0, 0};
+    for (int k = 1; k <= max; k++) {
+        const ReachIndex::Counts& total = reachIndex->at(v, k);
+        if (total.airports == previous.airports) break;
+        counts.push_back({total.airports - previous.airports, total.cities - previous.cities,
+                          total.countries - previous.countries});
+        previous = total;
+    }
+    return counts;
+}
+
+/**
+ * Calculates the diameter of the network, in flights or in km. The diameter in flights is read from the hop matrix
+ * or from the eccentricities when they are available; otherwise it is certified by Graph::ifubDiameter with a few
+ * searches
+ * @param km - longest of the shortest routes in km (true) or in flights (false)
+ * @param searches - receives the number of searches used (0 if none was needed)
+ * @return diameter of the network
+ */
+double Supervisor::diameter(bool km, int& searches) {
+    searches = 0;
+    if (!km && hopMatrix) return hopMatrix->diameter();
+    if (!km && !eccentricities.empty()) return *max_element(eccentricities.begin(), eccentricities.end());
+    return graph.ifubDiameter(km, workspace, searches);
+}
+
+/**
+ * Calculates the eccentricity of an airport: the largest number of flights needed to reach another airport from it.
+ * The eccentricities of every airport are computed together on first use, unless the hop matrix is enabled
+ * @param v - node of the airport
+ * @return eccentricity of the airport, 0 if it has no departures
+ */
+int Supervisor::eccentricity(int v) {
+    if (hopMatrix) return hopMatrix->eccentricity(v);
+    if (eccentricities.empty()) eccentricities = graph.eccentricities();
+    return eccentricities[v];
+}
+
 /**
  * Calculates the number of airports that belong to each country\n\n
  * <b>Complexity\n</b>
@@ -213,15 +396,12 @@ int Supervisor::countAirlinesPerCountry(const string& country) {
  * Calculates the total number of flights\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(|V|)</b>, V -> number of nodes
+ *      <b>O(1)</b>
  * </pre>
  * @return number of flights
  */
 int Supervisor::nrFlights(){
-    int nrFlights = 0;
-    for (const auto& node: graph.getNodes())
-        nrFlights += node.adj.size();
-    return nrFlights;
+    return graph.totalFlights();
 }
 
 /**
@@ -273,75 +453,243 @@ multimap<int,string> Supervisor::convertMap(const map<string, int>& m) {
  * </pre>
  */
 void Supervisor::createAirports() {
-    ifstream myFile;
-    string currentLine, code, name, city, country, x;
+    CsvReader csv(DATA_DIR "airports.csv");
     double latitude, longitude;
     int i = 1;
-    myFile.open("../data/airports.csv");
-    getline(myFile, currentLine);
-
-    while (getline(myFile,currentLine)){
-        istringstream iss(currentLine);
-
-        getline(iss,code,',');
-        getline(iss,name,',');
-        getline(iss,city,',');
-        getline(iss,country,',');
-        getline(iss,x,','); latitude = stod(x);
-        getline(iss,x,','); longitude = stod(x);
-
-        Airport airport = Airport(code,name,city,country,latitude,longitude);
-        graph.addAirport(i,airport);
-        airportsPerCity[{airport.getCountry(),airport.getCity()}].push_back(code);
-        idAirports.insert({airport.getCode(),i++});
-        airports.insert(airport);
-        countries.insert(country);
-        cities.insert(city);
-        citiesPerCountry[country].push_back(city);
+    csv.next();
+
+    while (csv.next()){
+        if (csv.size() < 6) continue;
+        if (!CsvReader::toDouble(csv[4], latitude) || !CsvReader::toDouble(csv[5], longitude)) continue;
+        registerAirport(i++, Airport(string(csv[0]),string(csv[1]),string(csv[2]),string(csv[3]),latitude,longitude));
     }
 }
 /**
- * Reads airlines.csv file and stores the information in airlines\n\n
+ * Reads airlines.csv file and stores the information in airlines.
+ * Each airline is interned in the graph under a dense id (its order in the file)\n\n
  * <b>Complexity\n</b>
  * <pre>
  *      <b>O(n)</b>, n -> file lines
  * </pre>
  */
 void Supervisor::createAirlines() {
-    ifstream inFile;
-    string code, name, callsign, country, line;
-    inFile.open("../data/airlines.csv");
-    getline(inFile, line);
-    while(getline(inFile, line)){
-        istringstream is(line);
-        getline(is,code,',');
-        getline(is,name,',');
-        getline(is,callsign,',');
-        getline(is,country,',');
-        Airline a = Airline(code, name, callsign, country);
-        airlines.insert(a);
+    CsvReader csv(DATA_DIR "airlines.csv");
+    int i = 0;
+    csv.next();
+    while(csv.next()){
+        if (csv.size() < 4) continue;
+        registerAirline(i++, Airline(string(csv[0]), string(csv[1]), string(csv[2]), string(csv[3])));
     }
 }
+
+/**
+ * Stores an airport in the graph under node id and in airportsPerCity, idAirports, airports, cities, countries
+ * and citiesPerCountry\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param id - node of the airport
+ * @param airport - airport
+ */
+void Supervisor::registerAirport(int id, const Airport& airport) {
+    graph.addAirport(id,airport);
+    airportsPerCity[{airport.getCountry(),airport.getCity()}].push_back(airport.getCode());
+    idAirports.insert({airport.getCode(),id});
+    airports.insert(airport);
+    countries.insert(airport.getCountry());
+    cities.insert(airport.getCity());
+    citiesPerCountry[airport.getCountry()].push_back(airport.getCity());
+}
+
+/**
+ * Interns an airline in the graph under a dense id and stores it in airlines\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b>
+ * </pre>
+ * @param id - dense airline id
+ * @param airline - airline
+ */
+void Supervisor::registerAirline(int id, const Airline& airline) {
+    graph.addAirline(id, airline);
+    airlines.insert(airline);
+}
+
+/**
+ * Maps the compiled snapshot of the network. The airport and airline tables are read from it and the graph traverses
+ * the mapped CSR edges (with their precomputed distances) in place, so nothing is parsed or recomputed\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n + m)</b>, n -> number of airports, m -> number of airlines
+ * </pre>
+ * @param stamp - stamp of the current CSV files
+ * @return true if an up to date snapshot was loaded
+ */
+bool Supervisor::loadSnapshot(const DataStamp& stamp) {
+    auto snapshot = Snapshot::open(DATA_DIR "renair.snap", stamp);
+    if (!snapshot || snapshot->nrAirports() != graph.getSize()) return false;
+
+    for (int i = 1; i <= snapshot->nrAirports(); i++)
+        registerAirport(i, snapshot->airport(i));
+    for (int i = 0; i < snapshot->nrAirlines(); i++)
+        registerAirline(i, snapshot->airline(i));
+    snapshot->attach(graph);
+    return true;
+}
+
+/**
+ * Reads the contraction hierarchy of the network, or builds it (and writes it for the next start) if its file is
+ * missing or was built from other CSV files\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(|V| + a)</b> to read it, V -> number of nodes, a -> number of arcs (see ContractionHierarchy::build to build it)
+ * </pre>
+ * @param stamp - stamp of the current CSV files
+ */
+void Supervisor::loadHierarchy(const DataStamp& stamp) {
+    auto start = chrono::steady_clock::now();
+    hierarchy = ContractionHierarchy::open(DATA_DIR "renair.ch", stamp, graph.getSize());
+    if (!hierarchy) {
+        hierarchy = ContractionHierarchy::build(graph);
+        hierarchy->write(DATA_DIR "renair.ch", stamp);
+        loadStats.hierarchyBuilt = true;
+    }
+    loadStats.hierarchySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+/**
+ * Maps the hop matrix of the network, or builds it (and writes it for the next start) if its file is missing or was
+ * built from other CSV files\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b> to map it (see HopMatrix::build to build it)
+ * </pre>
+ * @param stamp - stamp of the current CSV files
+ */
+void Supervisor::loadHopMatrix(const DataStamp& stamp) {
+    auto start = chrono::steady_clock::now();
+    hopMatrix = HopMatrix::open(DATA_DIR "renair.hops", stamp, graph.getSize());
+    if (!hopMatrix) {
+        hopMatrix = HopMatrix::build(graph);
+        hopMatrix->write(DATA_DIR "renair.hops", stamp);
+        loadStats.hopMatrixBuilt = true;
+    }
+    loadStats.hopMatrixSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Maps the reach index of the network, or builds it (and writes it for the next start) if its file is missing or was
+ * built from other CSV files\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(1)</b> to map it (see ReachIndex::build to build it)
+ * </pre>
+ * @param stamp - stamp of the CSV files the graph was built from
+ */
+void Supervisor::loadReachIndex(const DataStamp& stamp) {
+    auto start = chrono::steady_clock::now();
+    reachIndex = ReachIndex::open(DATA_DIR "renair.reach", stamp, graph.getSize());
+    if (!reachIndex) {
+        reachIndex = ReachIndex::build(graph);
+        reachIndex->write(DATA_DIR "renair.reach", stamp);
+        loadStats.reachIndexBuilt = true;
+    }
+    loadStats.reachIndexSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
 /**
  * Reads flights.csv file and stores the airports information in graphs about the flights
- * (airport of departure/arrival and distance between them)\n\n
+ * (airport of departure/arrival and distance between them).
+ * The file is split into line-aligned chunks that are parsed and resolved in parallel, one thread per core, into
+ * per-thread flight buffers that are then merged into the graph in file order. An airline missing from airlines.csv
+ * is interned by its code during the merge, so its flights are kept. The rows parsed and the time taken are kept in
+ * loadStats\n\n
  * <b>Complexity\n</b>
  * <pre>
- *      <b>O(n*log(n))</b>, n -> file lines
+ *      <b>O(n/t + |V| + |E|)</b>, n -> file lines, t -> number of threads, V -> number of nodes, E -> number of edges
  * </pre>
  */
 void Supervisor::createGraph(){
-    ifstream inFile;
-    string source, target, airline, line;
-    inFile.open("../data/flights.csv");
-    getline(inFile, line);
-    while(getline(inFile, line)){
-        istringstream is(line);
-        getline(is,source,',');
-        getline(is,target,',');
-        getline(is,airline,',');
-        auto d = Graph::distance(airports.find(Airport(source))->getLatitude(),airports.find(Airport(source))->getLongitude()
-                ,airports.find(Airport(target))->getLatitude(),airports.find(Airport(target))->getLongitude());
-        graph.addEdge(idAirports[source],idAirports[target],Airline(airline),d);
+    auto start = chrono::steady_clock::now();
+    auto file = MappedFile::open(DATA_DIR "flights.csv");
+    if (!file) return;
+    const char* begin = file->data();
+    const char* end = begin + file->size();
+    begin = find(begin, end, '\n');
+    if (begin != end) begin++;
+
+    int nrChunks = max(1, (int) thread::hardware_concurrency());
+    if (find(begin, end, '"') != end) nrChunks = 1;  // a quoted field may hold a line break, so do not split the file
+
+    vector<const char*> bounds = {begin};
+    for (int i = 1; i < nrChunks; i++) {
+        const char* p = max(bounds.back(), begin + (end - begin) * i / nrChunks);
+        p = find(p, end, '\n');
+        if (p != end) p++;
+        bounds.push_back(p);
     }
-}
\ No newline at end of file
+    bounds.push_back(end);
+
+    vector<FlightChunk> chunks(nrChunks);
+    vector<thread> workers;
+    for (int i = 1; i < nrChunks; i++)
+        workers.emplace_back(&Supervisor::parseFlights, this, bounds[i], bounds[i+1], ref(chunks[i]));
+    parseFlights(bounds[0], bounds[1], chunks[0]);
+    for (auto& worker : workers)
+        worker.join();
+
+    for (auto& chunk : chunks) {
+        for (const auto& unknown : chunk.unknownAirlines) {
+            int id = graph.getAirlineId(unknown.second);
+            if (id == -1) {
+                id = graph.nrAirlines();
+                registerAirline(id, Airline(unknown.second));
+                loadStats.unknownAirlines++;
+            }
+            chunk.flights[unknown.first].airline = id;
+        }
+        graph.addEdges(chunk.flights);
+        loadStats.rows += chunk.rows;
+        loadStats.skippedRows += chunk.skippedRows;
+    }
+    graph.buildCSR();
+    loadStats.threads = nrChunks;
+    loadStats.ingestSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Parses the flights of a line-aligned chunk of flights.csv, resolving the airports and airline of each row, and then
+ * the distances of all of its flights with one call to the batch kernel. Only reads the supervisor, so several chunks
+ * can be parsed at the same time\n\n
+ * <b>Complexity\n</b>
+ * <pre>
+ *      <b>O(n)</b>, n -> lines of the chunk
+ * </pre>
+ * @param begin - first character of the chunk
+ * @param end - one past the last character of the chunk
+ * @param chunk - receives the flights, the airline codes that still have to be interned and the row counts
+ */
+void Supervisor::parseFlights(const char* begin, const char* end, FlightChunk& chunk) const {
+    CsvReader csv(begin, end);
+    vector<Graph::Flight>& flights = chunk.flights;
+    vector<int> sources, targets;
+    while(csv.next()){
+        chunk.rows++;
+        if (csv.size() < 3) continue;
+        int source = getId(string(csv[0])), target = getId(string(csv[1]));
+        if (source == 0 || target == 0) {
+            chunk.skippedRows++;
+            continue;
+        }
+        string airline(csv[2]);
+        int id = graph.getAirlineId(airline);
+        if (id == -1) chunk.unknownAirlines.emplace_back(flights.size(), std::move(airline));
+        flights.push_back({source, target, id, 0});
+        sources.push_back(source);
+        targets.push_back(target);
+    }
+
+    vector<double> distances(flights.size());
+    graph.getCoordinates().distances(sources.data(), targets.data(), (int) flights.size(), distances.data());
+    for (size_t i = 0; i < flights.size(); i++)
+        flights[i].distance = distances[i];
+}
@@ -6,21 +6,64 @@
 #include <fstream>
 #include <istream>
 #include <sstream>
+#include <thread>
+#include <chrono>
 #include "airport.h"
 #include "airline.h"
 #include "graph.h"
+#include "snapshot.h"
+#include "csvReader.h"
+#include "contractionHierarchy.h"
+#include "hopMatrix.h"
+#include "reachIndex.h"
+#include "spatialIndex.h"
+#include "airportStats.h"
 using namespace std;
 
+#define DATA_DIR "../data/"
+
 class Supervisor {
 public:
+    struct LoadStats {
+        bool snapshot = false;   // network mapped from the compiled snapshot instead of read from the CSV files
+        int threads = 0;         // threads that ingested flights.csv
+        long rows = 0;           // rows of flights.csv parsed
+        long skippedRows = 0;    // rows left out because an airport is not in airports.csv
+        int unknownAirlines = 0;   // airlines of flights.csv that are not in airlines.csv, interned by their code
+        double seconds = 0;      // time spent loading the network (mapping the snapshot or reading the CSV files)
+        double ingestSeconds = 0;   // time spent ingesting flights.csv, from parsing the chunks to merging them
+        double indexSeconds = 0;    // time spent building the airport indexes (per country, spatial, statistics)
+        bool hierarchyBuilt = false;   // contraction hierarchy built now instead of read from its file
+        double hierarchySeconds = 0;   // time spent building or reading it
+        bool hopMatrixBuilt = false;   // hop matrix built now instead of mapped from its file
+        double hopMatrixSeconds = 0;   // time spent building or mapping it
+        bool reachIndexBuilt = false;   // reach index built now instead of mapped from its file
+        double reachIndexSeconds = 0;   // time spent building or mapping it
+    };
+
+    struct Options {
+        bool contractionHierarchy = false;   // answer unfiltered distance queries with a contraction hierarchy (--ch)
+        bool hopMatrix = false;              // answer unfiltered flight queries from an all-pairs hop matrix (--hops)
+        bool reachIndex = false;             // answer reach counts of up to REACH_LAYERS flights from an index (--reach)
+    };
+
     Supervisor();
+    explicit Supervisor(const Options& options);
 
     Airport::AirportH const& getAirports() const;
     Airline::AirlineH const& getAirlines() const;
     Airport::CityH const &getCity() const;
-    Graph getGraph() const;
-    unordered_map<string,int> getMap() const;
-    map<string,int> getNrAirportsPerCountry() const;
+    Graph const& getGraph() const;
+    unordered_map<string,int> const& getMap() const;
+    int getId(const string& airport) const;
+    vector<int> getIds(const vector<string>& airports) const;
+    bool airportsOf(const string& spec, vector<int>& ids) const;
+    map<string,int> const& getNrAirportsPerCountry() const;
+    LoadStats const& getLoadStats() const;
+    const ContractionHierarchy* getHierarchy() const;
+    const HopMatrix* getHopMatrix() const;
+    const ReachIndex* getReachIndex() const;
+    AirportStats const& getAirportStats() const;
 
     bool isCountry(const string& country);
     bool isAirport(const Airport& airport);
@@ -29,8 +72,16 @@ public:
     bool isValidCity(const string& country, const string& city);
 
     vector<string> localAirports(double, double, double);
+    vector<pair<string, double>> nearestAirports(double latitude, double longitude, int k) const;
     list<pair<string,string>> processFlight(int&, const vector<string>&,const vector<string>&,const Airline::AirlineH&);
     list<pair<string,string>> processDistance(double&, const vector<string>&,const vector<string>&,const Airline::AirlineH&);
+    RouteMatrix routeMatrix(RouteMatrix::Criterion criterion, const vector<int>& src, const vector<int>& dest,
+                            const Airline::AirlineH& airlines) const;
+
+    Graph::Reach reach(int v, int max);
+    vector<Graph::Reach::Layer> reachCounts(int v, int max);
+    double diameter(bool km, int& searches);
+    int eccentricity(int v);
 
     void countAirportsPerCountry();
     int countAirlinesPerCountry(const string& country);
@@ -41,16 +92,39 @@ private:
     void createAirports();
     void createAirlines();
     void createGraph();
+    // Flights parsed from one chunk of flights.csv
+    struct FlightChunk {
+        vector<Graph::Flight> flights;
+        vector<pair<size_t, string>> unknownAirlines;   // flights whose airline is not interned yet, with its code
+        long rows = 0;           // rows parsed
+        long skippedRows = 0;    // rows left out because an airport is unknown
+    };
+
+    void parseFlights(const char* begin, const char* end, FlightChunk& chunk) const;
+    bool loadSnapshot(const DataStamp& stamp);
+    void loadHierarchy(const DataStamp& stamp);
+    void loadHopMatrix(const DataStamp& stamp);
+    void loadReachIndex(const DataStamp& stamp);
+    void registerAirport(int id, const Airport& airport);
+    void registerAirline(int id, const Airline& airline);
 
     Airport::AirportH airports;
     Airline::AirlineH airlines;
     Graph graph = Graph(3019);
+    SearchWorkspace workspace;
+    SpatialIndex spatialIndex;
+    AirportStats airportStats;
     unordered_map<string, int> idAirports;
     unordered_set<string> countries;
     unordered_set<string> cities;
     Airport::CityH airportsPerCity;
     unordered_map<string, list<string>> citiesPerCountry;
     map<string, int> nrAirportsPerCountry;
+    LoadStats loadStats;
+    shared_ptr<ContractionHierarchy> hierarchy;
+    shared_ptr<HopMatrix> hopMatrix;
+    shared_ptr<ReachIndex> reachIndex;
+    vector<int> eccentricities;   // of every node, computed on first use
 };
 
 #endif //SUPERVISOR_H
@@ -1,9 +1,97 @@
 #include "classes/menu.h"
 
 using namespace std;
-int main() {
-    Menu menu;
+
+/**
+ * Writes a distance or flights matrix between two sets of airports and reports how fast it was computed
+ * @param options - options of the supervisor
+ * @param args - origins, destinations, criterion ("voos" or "km") and output file
+ * @return exit status
+ */
+static int exportMatrix(const Supervisor::Options& options, const vector<string>& args) {
+    RouteMatrix::Criterion criterion;
+    if (args[2] == "voos") criterion = RouteMatrix::FLIGHTS;
+    else if (args[2] == "km") criterion = RouteMatrix::DISTANCE;
+    else {
+        cerr << "Critério inválido: " << args[2] << " (use voos ou km)\n";
+        return 1;
+    }
+
+    Supervisor supervisor(options);
+    vector<int> from, to;
+    if (!supervisor.airportsOf(args[0], from) || !supervisor.airportsOf(args[1], to)) {
+        cerr << "Aeroporto ou país inválido em " << (from.empty() ? args[0] : args[1]) << "\n";
+        return 1;
+    }
+
+    RouteMatrix matrix = supervisor.routeMatrix(criterion, from, to, {});
+    const string& path = args[3];
+    bool binary = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    if (!(binary ? matrix.writeBinary(path, supervisor.getGraph()) : matrix.writeCsv(path, supervisor.getGraph()))) {
+        cerr << "Não foi possível escrever " << path << "\n";
+        return 1;
+    }
+    printf("Matriz %dx%d escrita em %s\n", matrix.rows(), matrix.cols(), path.c_str());
+    printf("Calculada em %.1f ms com %d threads (%.0f células/s)\n",
+           matrix.getSeconds() * 1000, matrix.getThreads(), matrix.cellsPerSecond());
+    return 0;
+}
+
+/**
+ * Writes the number of airports, cities and countries that every airport reaches with at most 1 to REACH_LAYERS
+ * flights, read from the reach index
+ * @param options - options of the supervisor
+ * @param path - output file
+ * @return exit status
+ */
+static int exportReachTable(Supervisor::Options options, const string& path) {
+    options.reachIndex = true;
+    Supervisor supervisor(options);
+    const auto& stats = supervisor.getLoadStats();
+    if (!supervisor.getReachIndex()->writeCsv(path, supervisor.getGraph())) {
+        cerr << "Não foi possível escrever " << path << "\n";
+        return 1;
+    }
+    printf("Tabela de alcance de %d aeroportos escrita em %s\n", supervisor.getReachIndex()->getSize(), path.c_str());
+    printf("Índice %s em %.1f ms\n", stats.reachIndexBuilt ? "construído" : "carregado", stats.reachIndexSeconds * 1000);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    Supervisor::Options options;
+    vector<string> matrix;
+    string reachTable;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--ch") options.contractionHierarchy = true;
+        else if (arg == "--hops") options.hopMatrix = true;
+        else if (arg == "--reach") options.reachIndex = true;
+        else if (arg == "--reach-table" && i + 1 < argc) reachTable = argv[++i];
+        else if (arg == "--matrix" && i + 4 < argc) {
+            matrix.assign(argv + i + 1, argv + i + 5);
+            i += 4;
+        }
+        else {
+            cerr << "Opção desconhecida: " << arg << "\n"
+                 << "Uso: " << argv[0] << " [--ch] [--hops] [--reach] [--matrix ORIGENS DESTINOS voos|km FICHEIRO]\n"
+                 << "       " << argv[0] << " [--reach-table FICHEIRO]\n"
+                 << "  --ch      usar uma hierarquia de contração nas pesquisas por distância sem filtro de companhias\n"
+                 << "  --hops    usar uma matriz pré-calculada do número mínimo de voos entre todos os aeroportos\n"
+                 << "            nas pesquisas sem filtro de companhias (construída uma vez e guardada em data/renair.hops)\n"
+                 << "  --reach   usar um índice pré-calculado do número de aeroportos, cidades e países alcançáveis\n"
+                 << "            com até " << REACH_LAYERS << " voos (construído uma vez e guardado em data/renair.reach)\n"
+                 << "  --matrix  escrever a matriz de voos ou distâncias entre dois conjuntos de aeroportos e sair;\n"
+                 << "            ORIGENS e DESTINOS são listas de códigos de aeroportos e países separadas por\n"
+                 << "            vírgulas (* para todos), FICHEIRO é escrito em binário se terminar em .bin, senão em CSV\n"
+                 << "  --reach-table  escrever em CSV o alcance de todos os aeroportos com 1 a " << REACH_LAYERS
+                 << " voos e sair\n";
+            return 1;
+        }
+    }
+    if (!matrix.empty()) return exportMatrix(options, matrix);
+    if (!reachTable.empty()) return exportReachTable(options, reachTable);
+
+    Menu menu(options);
     menu.init();
     Menu::end();
 }
-